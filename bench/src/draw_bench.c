@@ -0,0 +1,102 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   draw_bench.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:03:51 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 07:08:35 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "MLX42/MLX42.h"
+
+#define WIDTH 3840
+#define HEIGHT 2160
+#define RUNS 20
+
+typedef void (*draw_t)(mlx_image_t* dst, const mlx_image_t* src);
+
+static void draw_put_pixel(mlx_image_t* dst, const mlx_image_t* src)
+{
+	(void)src;
+	for (uint32_t y = 0; y < dst->height; y++)
+		for (uint32_t x = 0; x < dst->width; x++)
+			mlx_put_pixel(dst, x, y, 0x336699FF);
+}
+
+static void draw_fill_rect(mlx_image_t* dst, const mlx_image_t* src)
+{
+	(void)src;
+	mlx_fill_rect(dst, 0, 0, dst->width, dst->height, 0x336699FF);
+}
+
+static void draw_clear(mlx_image_t* dst, const mlx_image_t* src)
+{
+	(void)src;
+	mlx_clear_image(dst, 0x336699FF);
+}
+
+static void draw_copy_rect(mlx_image_t* dst, const mlx_image_t* src)
+{
+	mlx_copy_rect(dst, 0, 0, src, 0, 0, src->width, src->height);
+}
+
+static void draw_blend_rect(mlx_image_t* dst, const mlx_image_t* src)
+{
+	mlx_blend_rect(dst, 0, 0, src, 0, 0, src->width, src->height);
+}
+
+static void draw_blit_add(mlx_image_t* dst, const mlx_image_t* src)
+{
+	mlx_blit_image(dst, src, 0, 0, MLX_BLEND_ADD);
+}
+
+static void draw_blit_multiply(mlx_image_t* dst, const mlx_image_t* src)
+{
+	mlx_blit_image(dst, src, 0, 0, MLX_BLEND_MULTIPLY);
+}
+
+static void bench_run(const char* name, draw_t draw, mlx_image_t* dst, const mlx_image_t* src)
+{
+	draw(dst, src);
+	const double start = mlx_get_time();
+	for (int32_t i = 0; i < RUNS; i++)
+		draw(dst, src);
+	const double total = (mlx_get_time() - start) / RUNS;
+
+	printf("%-12s %12.3f %12.2f\n", name, total * 1000, (double)WIDTH * HEIGHT / total / 1e6);
+}
+
+int32_t main(void)
+{
+	mlx_set_setting(MLX_HEADLESS, true);
+
+	mlx_t* mlx = mlx_init(256, 256, "Bench", false);
+	if (!mlx)
+		return (EXIT_FAILURE);
+
+	mlx_image_t* dst = mlx_new_image(mlx, WIDTH, HEIGHT);
+	mlx_image_t* src = mlx_new_image(mlx, WIDTH, HEIGHT);
+	if (!dst || !src)
+		return (EXIT_FAILURE);
+
+	// Mix of opaque, translucent and transparent pixels.
+	for (uint32_t i = 0; i < WIDTH * HEIGHT; i++)
+		((uint32_t*)src->pixels)[i] = (i % 3 == 0 ? 0x00 : i % 3 == 1 ? 0x80 : 0xFF) << 24 | 0x804020;
+
+	printf("%dx%d image\n", WIDTH, HEIGHT);
+	printf("%-12s %12s %12s\n", "FUNCTION", "TIME (ms)", "MPIXEL/S");
+	bench_run("PUT_PIXEL", draw_put_pixel, dst, src);
+	bench_run("FILL_RECT", draw_fill_rect, dst, src);
+	bench_run("CLEAR", draw_clear, dst, src);
+	bench_run("COPY_RECT", draw_copy_rect, dst, src);
+	bench_run("BLEND_RECT", draw_blend_rect, dst, src);
+	bench_run("BLIT_ADD", draw_blit_add, dst, src);
+	bench_run("BLIT_MUL", draw_blit_multiply, dst, src);
+	mlx_terminate(mlx);
+	return (EXIT_SUCCESS);
+}
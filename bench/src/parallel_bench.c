@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   parallel_bench.c                                   :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:16:23 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 07:16:23 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "MLX42/MLX42.h"
+
+#define WIDTH 1920
+#define HEIGHT 1080
+#define ITERATIONS 256
+#define RUNS 5
+
+// Renders a part of the mandelbrot set, the cost of tiles differs a lot.
+static void bench_tile(mlx_image_t* image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, void* param)
+{
+	(void)param;
+	for (uint32_t py = y; py < y + height; py++)
+	{
+		for (uint32_t px = x; px < x + width; px++)
+		{
+			const double cx = (px - WIDTH * 0.7) / (HEIGHT * 0.4);
+			const double cy = (py - HEIGHT * 0.5) / (HEIGHT * 0.4);
+			double zx = 0, zy = 0;
+			uint32_t i = 0;
+
+			for (; i < ITERATIONS && zx * zx + zy * zy < 4; i++)
+			{
+				const double t = zx * zx - zy * zy + cx;
+				zy = 2 * zx * zy + cy;
+				zx = t;
+			}
+			mlx_put_pixel_unsafe(image, px, py, i * 0x010305 << 8 | 0xFF);
+		}
+	}
+}
+
+static double bench_run(int32_t threads)
+{
+	mlx_set_setting(MLX_THREADS, threads);
+
+	mlx_t* mlx = mlx_init(256, 256, "Bench", false);
+	mlx_image_t* img = mlx ? mlx_new_image(mlx, WIDTH, HEIGHT) : NULL;
+	if (!img)
+		exit(EXIT_FAILURE);
+
+	mlx_parallel_tiles(mlx, img, 0, 0, bench_tile, NULL);
+	const double start = mlx_get_time();
+	for (int32_t i = 0; i < RUNS; i++)
+		mlx_parallel_tiles(mlx, img, 0, 0, bench_tile, NULL);
+	const double total = (mlx_get_time() - start) / RUNS;
+
+	mlx_terminate(mlx);
+	return (total);
+}
+
+int32_t main(void)
+{
+	const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+	mlx_set_setting(MLX_HEADLESS, true);
+
+	printf("%dx%d mandelbrot, %ld cores\n", WIDTH, HEIGHT, cores);
+	printf("%-12s %12s %12s\n", "THREADS", "TIME (ms)", "SPEEDUP");
+	const double single = bench_run(1);
+	printf("%-12d %12.3f %12.2f\n", 1, single * 1000, 1.0);
+	for (int32_t threads = 2; threads <= cores; threads *= 2)
+	{
+		const double time = bench_run(threads);
+		printf("%-12d %12.3f %12.2f\n", threads, time * 1000, single / time);
+	}
+	if (cores > 1 && (cores & (cores - 1)) != 0)
+	{
+		const double time = bench_run(cores);
+		printf("%-12ld %12.3f %12.2f\n", cores, time * 1000, single / time);
+	}
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   pixel_bench.c                                      :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:04:55 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 07:04:55 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "MLX42/MLX42.h"
+
+#define WIDTH 1920
+#define HEIGHT 1080
+#define RUNS 50
+
+typedef void (*fill_t)(mlx_image_t* img, uint32_t color);
+
+static void fill_checked(mlx_image_t* img, uint32_t color)
+{
+	for (uint32_t y = 0; y < img->height; y++)
+		for (uint32_t x = 0; x < img->width; x++)
+			mlx_put_pixel(img, x, y, color ^ x);
+}
+
+static void fill_unsafe(mlx_image_t* img, uint32_t color)
+{
+	for (uint32_t y = 0; y < img->height; y++)
+		for (uint32_t x = 0; x < img->width; x++)
+			mlx_put_pixel_unsafe(img, x, y, color ^ x);
+	mlx_image_mark_dirty(img, 0, 0, img->width, img->height);
+}
+
+static void bench_run(const char* name, fill_t fill, mlx_image_t* img)
+{
+	fill(img, 0);
+	const double start = mlx_get_time();
+	for (int32_t i = 0; i < RUNS; i++)
+		fill(img, (uint32_t)i << 8);
+	const double total = (mlx_get_time() - start) / RUNS;
+
+	printf("%-12s %12.3f %12.2f\n", name, total * 1000, (double)WIDTH * HEIGHT / total / 1e6);
+}
+
+int32_t main(void)
+{
+	mlx_set_setting(MLX_HEADLESS, true);
+
+	mlx_t* mlx = mlx_init(256, 256, "Bench", false);
+	if (!mlx)
+		return (EXIT_FAILURE);
+
+	mlx_image_t* img = mlx_new_image(mlx, WIDTH, HEIGHT);
+	if (!img)
+		return (EXIT_FAILURE);
+
+	printf("%dx%d image\n", WIDTH, HEIGHT);
+	printf("%-12s %12s %12s\n", "FUNCTION", "TIME (ms)", "MPIXEL/S");
+	bench_run("PUT_PIXEL", fill_checked, img);
+	bench_run("UNSAFE", fill_unsafe, img);
+	mlx_terminate(mlx);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   quad_bench.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:46:38 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 06:46:38 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "MLX42/MLX42_Int.h"
+
+#define QUADS 10000
+#define FRAMES 120
+
+// Six vertices of 5 floats and a texture index, as quads used to be batched.
+#define LEGACY_QUAD_SIZE (6 * 24)
+
+typedef struct bench
+{
+	mlx_t*	mlx;
+	int32_t	frame;
+	size_t	pushed;
+	double	start;
+	double	total;
+}	bench_t;
+
+static void bench_frame(void* param)
+{
+	bench_t* const b = param;
+	const mlx_ring_t* ring = &((mlx_ctx_t*)b->mlx->context)->vertices;
+
+	if (b->frame++ == 0)
+	{
+		b->start = mlx_get_time();
+		b->pushed = ring->pushed;
+	}
+	else if (b->frame > FRAMES)
+	{
+		b->total = mlx_get_time() - b->start;
+		b->pushed = ring->pushed - b->pushed;
+		mlx_close_window(b->mlx);
+	}
+}
+
+// Interleaved images are batched, a single image with all instances is drawn instanced.
+static void bench_run(const char* name, bool interleaved)
+{
+	bench_t b = {0};
+
+	if (!(b.mlx = mlx_init(1024, 1024, "Bench", false)))
+		exit(EXIT_FAILURE);
+
+	mlx_image_t* images[2] = {mlx_new_image(b.mlx, 8, 8), mlx_new_image(b.mlx, 8, 8)};
+	for (int32_t i = 0; i < QUADS; i++)
+		mlx_image_to_window(b.mlx, images[interleaved ? i % 2 : 0], (i * 8) % 1024, (i * 8) / 1024 * 8 % 1024);
+
+	mlx_loop_hook(b.mlx, bench_frame, &b);
+	mlx_loop(b.mlx);
+	mlx_terminate(b.mlx);
+
+	const size_t perframe = b.pushed / FRAMES;
+	printf("%-12s %12zu %12zu %12.3f\n", name, perframe, (size_t)QUADS * LEGACY_QUAD_SIZE, b.total / FRAMES * 1000);
+}
+
+int32_t main(void)
+{
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_set_setting(MLX_DIRTY_TRACKING, true);
+
+	printf("%d quads per frame\n", QUADS);
+	printf("%-12s %12s %12s %12s\n", "PATH", "BYTES", "LEGACY", "FRAME (ms)");
+	bench_run("BATCHED", true);
+	bench_run("INSTANCED", false);
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   sort_bench.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:34:09 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 06:34:09 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "MLX42/MLX42_Int.h"
+
+// Sorting is pure CPU work, so this drives it directly without a window.
+
+#define RUNS 10
+
+static const size_t g_sizes[] = {1000, 10000, 100000};
+
+typedef struct bench
+{
+	mlx_ctx_t		ctx;
+	mlx_image_t		image;
+	mlx_instance_t*	instances;
+}	bench_t;
+
+static void bench_setup(bench_t* b, size_t count)
+{
+	memset(b, 0, sizeof(bench_t));
+	b->instances = calloc(count, sizeof(mlx_instance_t));
+	b->ctx.render_queue = calloc(count, sizeof(draw_queue_t));
+	if (!b->instances || !b->ctx.render_queue)
+		exit(EXIT_FAILURE);
+
+	b->image.instances = b->instances;
+	b->image.count = count;
+	b->ctx.render_count = count;
+	b->ctx.render_capacity = count;
+	for (size_t i = 0; i < count; i++)
+	{
+		b->instances[i].z = rand() % 4096;
+		b->ctx.render_queue[i] = (draw_queue_t){&b->image, (int32_t)i, INT32_MIN};
+	}
+	mlx_sort_renderqueue(&b->ctx);
+}
+
+static void bench_teardown(bench_t* b)
+{
+	free(b->instances);
+	free(b->ctx.render_queue);
+	free(b->ctx.sort_buffer);
+}
+
+static double bench_time(void)
+{
+	struct timespec ts;
+
+	timespec_get(&ts, TIME_UTC);
+	return (ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+static bool bench_sorted(bench_t* b)
+{
+	for (size_t i = 1; i < b->ctx.render_count; i++)
+		if (b->ctx.render_queue[i - 1].z > b->ctx.render_queue[i].z)
+			return (false);
+	return (true);
+}
+
+// Changes the depth of the given amount of random instances, then sorts.
+static double bench_run(bench_t* b, size_t count, size_t changes)
+{
+	double total = 0;
+
+	for (size_t run = 0; run < RUNS; run++)
+	{
+		for (size_t i = 0; i < changes; i++)
+			b->instances[rand() % count].z = rand() % 4096;
+
+		const double start = bench_time();
+		mlx_sort_renderqueue(&b->ctx);
+		total += bench_time() - start;
+	}
+	if (!bench_sorted(b))
+	{
+		fprintf(stderr, "Render queue is not sorted!\n");
+		exit(EXIT_FAILURE);
+	}
+	return (total / RUNS * 1000);
+}
+
+int32_t main(void)
+{
+	bench_t b;
+
+	printf("%-8s %12s %12s %12s\n", "COUNT", "ALL (ms)", "1% (ms)", "ONE (ms)");
+	for (size_t i = 0; i < sizeof(g_sizes) / sizeof(*g_sizes); i++)
+	{
+		const size_t count = g_sizes[i];
+
+		bench_setup(&b, count);
+		const double all = bench_run(&b, count, count);
+		const double some = bench_run(&b, count, count / 100);
+		const double one = bench_run(&b, count, 1);
+		printf("%-8zu %12.3f %12.3f %12.3f\n", count, all, some, one);
+		bench_teardown(&b);
+	}
+	return (EXIT_SUCCESS);
+}
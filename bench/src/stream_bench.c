@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   stream_bench.c                                     :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:29:15 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 06:31:48 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "MLX42/MLX42.h"
+
+#define FRAMES 120
+
+typedef struct bench
+{
+	mlx_t*			mlx;
+	mlx_image_t*	img;
+	int32_t			frame;
+	double			start;
+	double			total;
+}	bench_t;
+
+// Redraw the whole canvas every frame like a software renderer would.
+static void bench_frame(void* param)
+{
+	bench_t* const b = param;
+
+	memset(b->img->pixels, b->frame & 0xFF, b->img->width * b->img->height * sizeof(int32_t));
+	if (b->frame++ == 0)
+		b->start = mlx_get_time();
+	else if (b->frame > FRAMES)
+	{
+		b->total = mlx_get_time() - b->start;
+		mlx_close_window(b->mlx);
+	}
+}
+
+typedef enum bench_mode
+{
+	DIRECT,
+	STREAM,
+	MAPPED,
+}	bench_mode_t;
+
+// Returns the average frame time in milliseconds.
+static double bench_run(uint32_t size, bench_mode_t mode)
+{
+	bench_t b = {0};
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	if (!(b.mlx = mlx_init(256, 256, "Bench", false)))
+		return (-1);
+	if (mode == MAPPED)
+		b.img = mlx_new_streaming_image(b.mlx, size, size);
+	else if ((b.img = mlx_new_image(b.mlx, size, size)) && !mlx_set_image_streaming(b.img, mode == STREAM))
+		b.img = NULL;
+	if (!b.img)
+		return (mlx_terminate(b.mlx), -1);
+	mlx_image_to_window(b.mlx, b.img, 0, 0);
+	mlx_loop_hook(b.mlx, bench_frame, &b);
+	mlx_loop(b.mlx);
+	mlx_terminate(b.mlx);
+	return (b.total / FRAMES * 1000.0);
+}
+
+int32_t main(void)
+{
+	const uint32_t sizes[] = {256, 512, 1024, 2048, 4096};
+
+	printf("Benchmark: image streaming (%d frames)\n", FRAMES);
+	printf("%10s %14s %14s %14s\n", "size", "direct (ms)", "stream (ms)", "mapped (ms)");
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(*sizes); i++)
+	{
+		const double direct = bench_run(sizes[i], DIRECT);
+		const double stream = bench_run(sizes[i], STREAM);
+		const double mapped = bench_run(sizes[i], MAPPED);
+		printf("%5ux%-4u %14.3f %14.3f %14.3f\n", sizes[i], sizes[i], direct, stream, mapped);
+	}
+	return (EXIT_SUCCESS);
+}
@@ -0,0 +1,65 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   transform_bench.c                                  :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:13:06 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 07:13:06 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "MLX42/MLX42.h"
+
+#define WIDTH 1920
+#define HEIGHT 1080
+#define RUNS 20
+
+// Zooms into the middle of the image while slightly rotating it, covering the whole destination.
+static void bench_run(const char* name, mlx_t* mlx, mlx_image_t* dst, const mlx_image_t* src, mlx_filter_t filter)
+{
+	const float scale = 4.5f;
+	const float angle = 0.1f;
+	const mlx_transform_t transform = {
+		cosf(angle) * scale, -sinf(angle) * scale, sinf(angle) * scale, cosf(angle) * scale,
+		WIDTH / 2 - (cosf(angle) - sinf(angle)) * scale * src->width / 2,
+		HEIGHT / 2 - (sinf(angle) + cosf(angle)) * scale * src->height / 2,
+	};
+
+	mlx_blit_image_transformed(mlx, dst, src, &transform, filter, MLX_BLEND_ALPHA);
+	const double start = mlx_get_time();
+	for (int32_t i = 0; i < RUNS; i++)
+		mlx_blit_image_transformed(mlx, dst, src, &transform, filter, MLX_BLEND_ALPHA);
+	const double total = (mlx_get_time() - start) / RUNS;
+
+	printf("%-20s %12.3f %12.2f\n", name, total * 1000, (double)WIDTH * HEIGHT / total / 1e6);
+}
+
+int32_t main(void)
+{
+	mlx_set_setting(MLX_HEADLESS, true);
+
+	mlx_t* mlx = mlx_init(256, 256, "Bench", false);
+	if (!mlx)
+		return (EXIT_FAILURE);
+
+	mlx_image_t* dst = mlx_new_image(mlx, WIDTH, HEIGHT);
+	mlx_image_t* src = mlx_new_image(mlx, 512, 512);
+	if (!dst || !src)
+		return (EXIT_FAILURE);
+	for (uint32_t i = 0; i < src->width * src->height; i++)
+		((uint32_t*)src->pixels)[i] = 0xFF000000 | i * 2654435761u;
+
+	printf("%dx%d image into %dx%d\n", src->width, src->height, WIDTH, HEIGHT);
+	printf("%-20s %12s %12s\n", "FILTER", "TIME (ms)", "MPIXEL/S");
+	bench_run("NEAREST", NULL, dst, src, MLX_FILTER_NEAREST);
+	bench_run("BILINEAR", NULL, dst, src, MLX_FILTER_BILINEAR);
+	bench_run("NEAREST PARALLEL", mlx, dst, src, MLX_FILTER_NEAREST);
+	bench_run("BILINEAR PARALLEL", mlx, dst, src, MLX_FILTER_BILINEAR);
+	mlx_terminate(mlx);
+	return (EXIT_SUCCESS);
+}
@@ -6,7 +6,7 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2021/12/28 00:33:01 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/08/10 13:00:48 by lde-la-h      ########   odam.nl         */
+/*   Updated: 2026/10/18 08:27:07 by W2Wizard      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -144,6 +144,87 @@ typedef struct mlx
 	double		delta_time;
 }	mlx_t;
 
+// Amount of buckets of the frame time histogram, each bucket spans a millisecond.
+# define MLX_HISTOGRAM_SIZE 64
+
+/**
+ * Timings and counters of a single frame, see mlx_get_frame_stats.
+ * All timings are in milliseconds and only measured if the
+ * MLX_FRAME_STATS setting is enabled, the counters always are.
+ * 
+ * @param frame_time The time the entire frame took.
+ * @param hooks_time The time spent in the loop hooks.
+ * @param sort_time The time spent sorting the render queue by depth.
+ * @param upload_time The time spent uploading images to the GPU.
+ * @param draw_time The time spent batching and issuing draw calls.
+ * @param swap_time The time spent presenting the frame.
+ * @param gpu_time The time the GPU spent rendering, this is a couple of
+ * frames behind as it's read without waiting for the GPU. Negative if unknown.
+ * @param draw_calls The amount of draw calls issued.
+ * @param batches The amount of batches that were flushed.
+ * @param instances The amount of image instances drawn.
+ * @param sorts The amount of times the render queue was sorted.
+ * @param upload_bytes The amount of pixel data uploaded to the GPU.
+ * @param vertex_bytes The amount of vertex data uploaded to the GPU.
+ */
+typedef struct mlx_frame_stats
+{
+	double		frame_time;
+	double		hooks_time;
+	double		sort_time;
+	double		upload_time;
+	double		draw_time;
+	double		swap_time;
+	double		gpu_time;
+	uint32_t	draw_calls;
+	uint32_t	batches;
+	uint32_t	instances;
+	uint32_t	sorts;
+	uint64_t	upload_bytes;
+	uint64_t	vertex_bytes;
+}	mlx_frame_stats_t;
+
+// The ways pixels can be blended onto an image, see mlx_blit_image.
+typedef enum mlx_blend
+{
+	MLX_BLEND_ALPHA = 0,		// Blends using the alpha of the source, like images are drawn onto the window.
+	MLX_BLEND_PREMULTIPLIED,	// Same as alpha blending, for colors that are already multiplied by their alpha.
+	MLX_BLEND_ADD,				// Adds the color weighted by its alpha, for light and glow effects.
+	MLX_BLEND_MULTIPLY,			// Multiplies the color weighted by its alpha, for shadows and tinting.
+	MLX_BLEND_MAX,				// Blend mode count.
+}	mlx_blend_t;
+
+// How pixels are sampled when drawing a transformed image, see mlx_blit_image_transformed.
+typedef enum mlx_filter
+{
+	MLX_FILTER_NEAREST = 0,	// Picks the closest pixel, keeps pixel art sharp.
+	MLX_FILTER_BILINEAR,	// Interpolates the four closest pixels, smooth when scaling or rotating.
+	MLX_FILTER_MAX,			// Filter count.
+}	mlx_filter_t;
+
+/**
+ * An affine transformation, such as a scale, rotation and translation,
+ * mapping the position of a pixel x, y in an image to:
+ * 
+ * (a * x + b * y + tx, c * x + d * y + ty)
+ * 
+ * @param a Scales x, or cos(angle) * scale when rotating.
+ * @param b Shears x by y, or -sin(angle) * scale when rotating.
+ * @param c Shears y by x, or sin(angle) * scale when rotating.
+ * @param d Scales y, or cos(angle) * scale when rotating.
+ * @param tx The X translation.
+ * @param ty The Y translation.
+ */
+typedef struct mlx_transform
+{
+	float	a;
+	float	b;
+	float	c;
+	float	d;
+	float	tx;
+	float	ty;
+}	mlx_transform_t;
+
 // The error codes used to idenfity the correct error message.
 typedef enum mlx_errno
 {
@@ -178,7 +259,12 @@ typedef enum mlx_settings
 	MLX_FULLSCREEN,			// Should the window be in Fullscreen, note it will fullscreen at the given resolution. Default: false
 	MLX_MAXIMIZED,			// Start the window in a maximized state, overwrites the fullscreen state if this is true. Default: false
 	MLX_DECORATED,			// Have the window be decorated with a window bar. Default: true
-	MLX_HEADLESS,			// Run in headless mode, no window is created. (NOTE: Still requires some form of window manager such as xvfb)
+	MLX_HEADLESS,			// Run in headless mode, rendering into an offscreen framebuffer. (NOTE: Without GLFW 3.4 still requires some form of window manager such as xvfb)
+	MLX_DIRTY_TRACKING,		// Only upload the modified regions of images to the GPU, see mlx_image_mark_dirty. Default: false
+	MLX_FRAME_STATS,		// Measure how long each part of a frame takes, see mlx_get_frame_stats. Default: false
+	MLX_SOFTWARE,			// Render on the CPU without OpenGL, into an offscreen framebuffer. Set before mlx_init. Default: false
+	MLX_THREADS,			// Amount of threads used for parallel work such as mlx_parallel_tiles, 0 for one per core. Set before mlx_init. Default: 0
+	MLX_PIPELINED,			// Render on a thread of its own while the next frame runs its hooks. Set before mlx_init. Default: false
 	MLX_SETTINGS_MAX,		// Setting count.
 }	mlx_settings_t;
 
@@ -239,6 +325,24 @@ typedef void (*mlx_resizefunc)(int32_t width, int32_t height, void* param);
  */
 typedef void (*mlx_closefunc)(void* param);
 
+/**
+ * Callback function used to render a tile of an image, see mlx_parallel_tiles
+ * and mlx_progressive_tiles.
+ * 
+ * WARNING: The function is called from multiple threads at once, each
+ * with a different tile, only write to the pixels of your own tile!
+ * Use mlx_put_pixel_unsafe or write to the pixels directly, the other
+ * functions of MLX42 are not thread safe.
+ * 
+ * @param[in] image The image being rendered.
+ * @param[in] x The X coordinate of the top left pixel of the tile.
+ * @param[in] y The Y coordinate of the top left pixel of the tile.
+ * @param[in] width The width of the tile.
+ * @param[in] height The height of the tile.
+ * @param[in] param Additional parameter to pass onto the function.
+ */
+typedef void (*mlx_tilefunc)(mlx_image_t* image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, void* param);
+
 //= Error Functions =//
 
 /**
@@ -316,6 +420,42 @@ void mlx_terminate(mlx_t* mlx);
  */
 double mlx_get_time(void);
 
+/**
+ * Retrieves the timings and counters of the last completed frame.
+ * 
+ * NOTE: The timings are only measured with the MLX_FRAME_STATS setting.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[out] stats The stats of the last frame.
+ */
+void mlx_get_frame_stats(mlx_t* mlx, mlx_frame_stats_t* stats);
+
+/**
+ * Retrieves a histogram of the frame times of the last couple hundred frames.
+ * Each bucket counts the frames that took that many milliseconds, the last
+ * bucket counts all frames that took longer.
+ * 
+ * NOTE: Only filled in with the MLX_FRAME_STATS setting.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[out] histogram The amount of frames per bucket.
+ */
+void mlx_get_frame_histogram(mlx_t* mlx, uint32_t histogram[MLX_HISTOGRAM_SIZE]);
+
+/**
+ * Starts tracing the render loop into a Chrome trace event file, which
+ * can be opened in chrome://tracing or the Perfetto UI.
+ * 
+ * Each hook, sort, texture upload, batch and buffer swap is recorded.
+ * Only the most recent events are kept and written to the file once
+ * mlx_terminate is called.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] path The path of the trace file to write.
+ * @returns Whether tracing was started.
+ */
+bool mlx_start_trace(mlx_t* mlx, const char* path);
+
 //= Window/Monitor Functions
 
 /**
@@ -389,6 +529,23 @@ void mlx_set_window_limit(mlx_t* mlx, int32_t min_w, int32_t min_h, int32_t max_
  */
 void mlx_set_window_title(mlx_t* mlx, const char* title);
 
+/**
+ * Reads back the pixels of the frame that is currently being rendered,
+ * this also works in headless mode where there is no window to show them.
+ * 
+ * The read happens asynchronously, the pixels are copied into dst at the
+ * end of this or one of the next two frames, or once mlx_terminate is
+ * called. Requesting another read within the same frame replaces the
+ * previous one.
+ * 
+ * NOTE: dst has to fit width * height RGBA pixels of the framebuffer,
+ * which is larger than the window on high DPI displays.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[out] dst The buffer to copy the pixels into, rows top to bottom.
+ */
+void mlx_read_framebuffer(mlx_t* mlx, uint8_t* dst);
+
 //= Input Functions =//
 
 /**
@@ -541,6 +698,18 @@ void mlx_resize_hook(mlx_t* mlx, mlx_resizefunc func, void* param);
  */
 bool mlx_loop_hook(mlx_t* mlx, void (*f)(void*), void* param);
 
+/**
+ * Same as mlx_loop_hook but with a name that identifies the hook in
+ * traces, see mlx_start_trace. Without one the function address is used.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] f The function.
+ * @param[in] param The parameter to pass onto the function.
+ * @param[in] name The name of the hook, copied.
+ * @returns Wether the hook was added successfuly. 
+ */
+bool mlx_named_loop_hook(mlx_t* mlx, void (*f)(void*), void* param, const char* name);
+
 //= Texture Functions =//
 
 /**
@@ -625,6 +794,192 @@ bool mlx_draw_texture(mlx_image_t* image, mlx_texture_t* texture, uint32_t x, ui
  */
 void mlx_put_pixel(mlx_image_t* image, uint32_t x, uint32_t y, uint32_t color);
 
+/**
+ * Sets / puts a pixel onto an image without any checks, meant for tight
+ * loops that already know their pixels are within the image.
+ *
+ * Unlike mlx_put_pixel this is inlined into your code and writes the
+ * pixel with a single store, but it does not mark the image as modified.
+ * With MLX_DIRTY_TRACKING enabled call mlx_image_mark_dirty once you
+ * are done drawing.
+ *
+ * NOTE: Putting a pixel beyond the bounds of the image is undefined behaviour.
+ *
+ * @param[in] image The image to draw on.
+ * @param[in] x The X coordinate position.
+ * @param[in] y The Y coordinate position.
+ * @param[in] color The color value to put.
+ */
+static inline void mlx_put_pixel_unsafe(mlx_image_t* image, uint32_t x, uint32_t y, uint32_t color)
+{
+	uint32_t* const pixel = (uint32_t*)image->pixels + (y * image->width + x);
+
+	// Pixels are stored as R, G, B, A bytes, colors as 0xRRGGBBAA.
+# if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	*pixel = color;
+# else
+	*pixel = color >> 24 | (color >> 8 & 0xFF00) | (color << 8 & 0xFF0000) | color << 24;
+# endif
+}
+
+/**
+ * Fills a rectangle of an image with a color, much faster than putting
+ * each pixel on its own.
+ * 
+ * NOTE: The rectangle is clipped to the bounds of the image.
+ * 
+ * @param[in] image The image to draw on.
+ * @param[in] x The X coordinate of the rectangle.
+ * @param[in] y The Y coordinate of the rectangle.
+ * @param[in] width The width of the rectangle.
+ * @param[in] height The height of the rectangle.
+ * @param[in] color The color to fill with.
+ */
+void mlx_fill_rect(mlx_image_t* image, int32_t x, int32_t y, uint32_t width, uint32_t height, uint32_t color);
+
+/**
+ * Draws a horizontal line onto an image, from left to right.
+ * 
+ * NOTE: The line is clipped to the bounds of the image.
+ * 
+ * @param[in] image The image to draw on.
+ * @param[in] x The X coordinate the line starts at.
+ * @param[in] y The Y coordinate of the line.
+ * @param[in] length The length of the line in pixels.
+ * @param[in] color The color of the line.
+ */
+void mlx_draw_hline(mlx_image_t* image, int32_t x, int32_t y, uint32_t length, uint32_t color);
+
+/**
+ * Draws a vertical line onto an image, from top to bottom.
+ * 
+ * NOTE: The line is clipped to the bounds of the image.
+ * 
+ * @param[in] image The image to draw on.
+ * @param[in] x The X coordinate of the line.
+ * @param[in] y The Y coordinate the line starts at.
+ * @param[in] length The length of the line in pixels.
+ * @param[in] color The color of the line.
+ */
+void mlx_draw_vline(mlx_image_t* image, int32_t x, int32_t y, uint32_t length, uint32_t color);
+
+/**
+ * Sets every pixel of an image to the same color.
+ * 
+ * @param[in] image The image to clear.
+ * @param[in] color The color to clear with.
+ */
+void mlx_clear_image(mlx_image_t* image, uint32_t color);
+
+/**
+ * Copies a rectangle of one image onto another, replacing the pixels.
+ * The images may be the same, even if the rectangles overlap.
+ * 
+ * NOTE: The rectangle is clipped to the bounds of both images.
+ * 
+ * @param[in] dst The image to copy to.
+ * @param[in] x The X coordinate in dst to copy to.
+ * @param[in] y The Y coordinate in dst to copy to.
+ * @param[in] src The image to copy from.
+ * @param[in] sx The X coordinate in src to copy from.
+ * @param[in] sy The Y coordinate in src to copy from.
+ * @param[in] width The width of the rectangle.
+ * @param[in] height The height of the rectangle.
+ */
+void mlx_copy_rect(mlx_image_t* dst, int32_t x, int32_t y, const mlx_image_t* src, int32_t sx, int32_t sy, uint32_t width, uint32_t height);
+
+/**
+ * Same as mlx_copy_rect but blends the pixels of src over those of dst
+ * using their alpha, the same way images are blended onto the window.
+ * 
+ * NOTE: The images have to be different images.
+ * 
+ * @param[in] dst The image to blend onto.
+ * @param[in] x The X coordinate in dst to blend to.
+ * @param[in] y The Y coordinate in dst to blend to.
+ * @param[in] src The image to blend from.
+ * @param[in] sx The X coordinate in src to blend from.
+ * @param[in] sy The Y coordinate in src to blend from.
+ * @param[in] width The width of the rectangle.
+ * @param[in] height The height of the rectangle.
+ */
+void mlx_blend_rect(mlx_image_t* dst, int32_t x, int32_t y, const mlx_image_t* src, int32_t sx, int32_t sy, uint32_t width, uint32_t height);
+
+/**
+ * Draws an entire image onto another image, blending the pixels
+ * with the given blend mode.
+ * 
+ * NOTE: Unlike mlx_draw_texture, whatever lies outside of dst is
+ * simply cut off. The images have to be different images.
+ * 
+ * @param[in] dst The image to draw onto.
+ * @param[in] src The image to draw.
+ * @param[in] x The X coordinate in dst to draw to.
+ * @param[in] y The Y coordinate in dst to draw to.
+ * @param[in] mode How the pixels are blended.
+ */
+void mlx_blit_image(mlx_image_t* dst, const mlx_image_t* src, int32_t x, int32_t y, mlx_blend_t mode);
+
+/**
+ * Same as mlx_blit_image but draws a texture, such as a loaded sprite.
+ * 
+ * @param[in] image The image to draw onto.
+ * @param[in] texture The texture to draw.
+ * @param[in] x The X coordinate in image to draw to.
+ * @param[in] y The Y coordinate in image to draw to.
+ * @param[in] mode How the pixels are blended.
+ */
+void mlx_blit_texture(mlx_image_t* image, const mlx_texture_t* texture, int32_t x, int32_t y, mlx_blend_t mode);
+
+/**
+ * Draws an entire image onto another image, scaled, rotated or otherwise
+ * transformed, blending the pixels with the given blend mode.
+ * 
+ * If a MLX handle is given, the rows are drawn in parallel on the worker
+ * threads of MLX, which is worth it for large images.
+ * 
+ * NOTE: The images have to be different images.
+ * 
+ * @param[in] mlx The MLX instance handle, or NULL to draw on the calling thread.
+ * @param[in] dst The image to draw onto.
+ * @param[in] src The image to draw.
+ * @param[in] transform The transformation from src to dst.
+ * @param[in] filter How the pixels of src are sampled.
+ * @param[in] mode How the pixels are blended.
+ */
+void mlx_blit_image_transformed(mlx_t* mlx, mlx_image_t* dst, const mlx_image_t* src, const mlx_transform_t* transform, mlx_filter_t filter, mlx_blend_t mode);
+
+/**
+ * Same as mlx_blit_image_transformed but draws a texture.
+ * 
+ * @param[in] mlx The MLX instance handle, or NULL to draw on the calling thread.
+ * @param[in] image The image to draw onto.
+ * @param[in] texture The texture to draw.
+ * @param[in] transform The transformation from texture to image.
+ * @param[in] filter How the pixels of texture are sampled.
+ * @param[in] mode How the pixels are blended.
+ */
+void mlx_blit_texture_transformed(mlx_t* mlx, mlx_image_t* image, const mlx_texture_t* texture, const mlx_transform_t* transform, mlx_filter_t filter, mlx_blend_t mode);
+
+/**
+ * Marks a region of the image as modified so that it gets uploaded
+ * to the GPU at the next frame.
+ * 
+ * Only relevant if the MLX_DIRTY_TRACKING setting is enabled, in which case
+ * images are only re-uploaded when a region of them has been marked.
+ * All of MLX's own drawing functions already do this, so this is only needed
+ * after writing to the pixel buffer of the image directly.
+ * 
+ * NOTE: The region is clipped to the bounds of the image.
+ * 
+ * @param[in] image The image that was modified.
+ * @param[in] x The X coordinate of the modified region.
+ * @param[in] y The Y coordinate of the modified region.
+ * @param[in] width The width of the modified region.
+ * @param[in] height The height of the modified region.
+ */
+void mlx_image_mark_dirty(mlx_image_t* image, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
 /**
  * Creates and allocates a new image buffer.
  * 
@@ -635,6 +990,23 @@ void mlx_put_pixel(mlx_image_t* image, uint32_t x, uint32_t y, uint32_t color);
  */
 mlx_image_t* mlx_new_image(mlx_t* mlx, uint32_t width, uint32_t height);
 
+/**
+ * Creates a group of images of the same size, e.g the frames of a sprite
+ * or the tiles of a tileset. All images of a group are drawn from the
+ * same texture, so any amount of them can be drawn in a single batch.
+ * 
+ * The images behave like any other image, when resized an image leaves
+ * its group.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] width The width of every image.
+ * @param[in] height The height of every image.
+ * @param[in] count The amount of images to create.
+ * @param[out] images Receives the images, must hold at least count images.
+ * @return True if all images were created, else false and none were.
+ */
+bool mlx_new_image_group(mlx_t* mlx, uint32_t width, uint32_t height, uint32_t count, mlx_image_t** images);
+
 /**
  * Draws a new instance of an image, it will then share the same
  * pixel buffer as the image.
@@ -678,6 +1050,69 @@ void mlx_delete_image(mlx_t* mlx, mlx_image_t* image);
  */
 bool mlx_resize_image(mlx_image_t* img, uint32_t nwidth, uint32_t nheight);
 
+/**
+ * Enables or disables streaming of an image to the GPU.
+ * 
+ * A streaming image keeps a ring of pixel buffers through which its pixels
+ * are uploaded asynchronously, this way the CPU does not have to wait for
+ * the driver to copy the image. Useful for big images that are (re)drawn
+ * every frame, e.g: a full-screen canvas, but a waste of memory otherwise.
+ * 
+ * @param[in] image The image to stream.
+ * @param[in] enable Whether or not the image should be streamed.
+ * @return True if successful, else false.
+ */
+bool mlx_set_image_streaming(mlx_image_t* image, bool enable);
+
+/**
+ * Creates a new streaming image whose pixel buffer is mapped memory of the
+ * driver, writing to the pixels writes directly into the memory the texture
+ * is updated from. This saves copying the entire image every frame.
+ * 
+ * Requires OpenGL 4.4, otherwise this is the same as a regular image with
+ * streaming enabled.
+ * 
+ * NOTE: The pixels are read by the GPU while a frame is being rendered.
+ * MLX waits for that to be done before running any hooks, so only write
+ * to the pixels from within hooks (or outside of mlx_loop). The wait is
+ * synchronous, every frame that uploads the image waits for the GPU to
+ * copy it into the texture. The ring of mlx_set_image_streaming doesn't.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] width The desired width of the image.
+ * @param[in] height The desired height of the image.
+ * @return Pointer to the image buffer, if it failed to allocate then NULL.
+ */
+mlx_image_t* mlx_new_streaming_image(mlx_t* mlx, uint32_t width, uint32_t height);
+
+/**
+ * Enables or disables buffering of an image, so another thread can draw
+ * into it while MLX draws what it last published with mlx_image_swap.
+ * 
+ * A buffered image has three pixel buffers, its pixels always point to
+ * the one the drawing thread owns. No locks are taken on either side.
+ * 
+ * NOTE: Enabling buffering disables streaming and the other way around.
+ * Only enable, disable or resize it while no other thread is drawing.
+ * 
+ * @param[in] image The image to buffer.
+ * @param[in] enable Whether or not the image should be buffered.
+ * @return True if successful, else false.
+ */
+bool mlx_set_image_buffering(mlx_image_t* image, bool enable);
+
+/**
+ * Publishes the pixels of a buffered image, they get drawn from the next
+ * frame on. Afterwards the pixels point to another buffer, which holds
+ * an older frame. Safe to call from any thread, but one at a time.
+ * 
+ * WARNING: Only draw into the pixels with mlx_put_pixel_unsafe or by
+ * writing to them directly. The whole image is uploaded on every swap.
+ * 
+ * @param[in] image The buffered image.
+ */
+void mlx_image_swap(mlx_image_t* image);
+
 /**
  * Sets the depth / Z axis value of an instance.
  * 
@@ -690,6 +1125,131 @@ bool mlx_resize_image(mlx_image_t* img, uint32_t nwidth, uint32_t nheight);
  */
 void mlx_set_instance_depth(mlx_instance_t* instance, int32_t zdepth);
 
+/**
+ * Posts a move of an instance, applied at the start of the next frame.
+ * 
+ * Images and their instances may only be changed from the main thread,
+ * the post functions can be called from any thread instead. Posted
+ * changes are applied at the start of a frame, before the loop hooks,
+ * in the order they were posted.
+ * 
+ * NOTE: Changes still waiting when their image gets deleted, directly or
+ * by a posted deletion, are dropped. Don't post about an image once its
+ * deletion may have been applied, i.e. from the frame after it was posted.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] image The image of the instance.
+ * @param[in] instance The index of the instance.
+ * @param[in] x The new X position.
+ * @param[in] y The new Y position.
+ * @return False if too many changes were posted this frame, else true.
+ */
+bool mlx_post_instance_move(mlx_t* mlx, mlx_image_t* image, int32_t instance, int32_t x, int32_t y);
+
+/**
+ * Posts a depth change of an instance, see mlx_set_instance_depth.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] image The image of the instance.
+ * @param[in] instance The index of the instance.
+ * @param[in] zdepth The new depth value.
+ * @return False if too many changes were posted this frame, else true.
+ */
+bool mlx_post_instance_depth(mlx_t* mlx, mlx_image_t* image, int32_t instance, int32_t zdepth);
+
+/**
+ * Posts enabling or disabling an instance.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] image The image of the instance.
+ * @param[in] instance The index of the instance.
+ * @param[in] enabled Whether the instance should be drawn.
+ * @return False if too many changes were posted this frame, else true.
+ */
+bool mlx_post_instance_enabled(mlx_t* mlx, mlx_image_t* image, int32_t instance, bool enabled);
+
+/**
+ * Posts a new instance of an image, see mlx_image_to_window. The index
+ * of the new instance is the amount of instances the image has by then.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] image The image to draw onto the screen.
+ * @param[in] x The X position.
+ * @param[in] y The Y position.
+ * @return False if too many changes were posted this frame, else true.
+ */
+bool mlx_post_image_to_window(mlx_t* mlx, mlx_image_t* image, int32_t x, int32_t y);
+
+/**
+ * Posts the deletion of an image, see mlx_delete_image. Changes to the
+ * image that were posted before, by any thread, are dropped along with it.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] image The image to delete.
+ * @return False if too many changes were posted this frame, else true.
+ */
+bool mlx_post_delete_image(mlx_t* mlx, mlx_image_t* image);
+
+/**
+ * Renders an image in parallel, by splitting it into tiles that are
+ * rendered on all cores at once. Returns once every tile is done and
+ * marks the image as modified, so the result is drawn this frame.
+ * 
+ * Tiles of 64 by 64 pixels fit nicely into the cache of a core. To render
+ * row by row instead, use tiles as wide as the image and one pixel high.
+ * 
+ * NOTE: Calling it again from within a tile renders the tiles of that
+ * call one after another on the calling thread.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] image The image to render.
+ * @param[in] tile_width The width of a tile, 0 for the default of 64.
+ * @param[in] tile_height The height of a tile, 0 for the default of 64.
+ * @param[in] func The function that renders a tile.
+ * @param[in] param Additional parameter to pass onto the function.
+ * @return False if the threads could not be started, else true.
+ */
+bool mlx_parallel_tiles(mlx_t* mlx, mlx_image_t* image, uint32_t tile_width, uint32_t tile_height, mlx_tilefunc func, void* param);
+
+/**
+ * Renders an image progressively, by splitting it into tiles that are
+ * rendered in the background on all cores. Returns right away, at the
+ * start of every frame the tiles finished since the last one are
+ * uploaded, so the image fills in while the window stays responsive.
+ * 
+ * Meant for renders that take longer than a frame, such as path tracers.
+ * Starting another render of the same image stops the previous one. Once
+ * every tile is done the threads are joined at the start of a frame.
+ * 
+ * NOTE: Resizing or deleting the image, or toggling its streaming,
+ * stops the render. Only read the pixels once mlx_progressive_done.
+ * 
+ * @param[in] image The image to render.
+ * @param[in] tile_width The width of a tile, 0 for the default of 64.
+ * @param[in] tile_height The height of a tile, 0 for the default of 64.
+ * @param[in] func The function that renders a tile.
+ * @param[in] param Additional parameter to pass onto the function.
+ * @return False if the threads could not be started, else true.
+ */
+bool mlx_progressive_tiles(mlx_image_t* image, uint32_t tile_width, uint32_t tile_height, mlx_tilefunc func, void* param);
+
+/**
+ * Checks if every tile of a progressive render of the image is done,
+ * they're drawn at the latest with the next frame.
+ * 
+ * @param[in] image The image being rendered.
+ * @return True if done or nothing is being rendered, else false.
+ */
+bool mlx_progressive_done(const mlx_image_t* image);
+
+/**
+ * Stops a progressive render of the image, waiting for the tiles that
+ * are being worked on. The finished tiles are still drawn.
+ * 
+ * @param[in] image The image being rendered.
+ */
+void mlx_progressive_cancel(mlx_image_t* image);
+
 //= String Functions =//
 
 /**
@@ -6,7 +6,7 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2021/12/27 23:55:34 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/07/21 10:46:43 by sbos          ########   odam.nl         */
+/*   Updated: 2026/10/18 08:27:07 by W2Wizard      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -38,11 +38,55 @@
 # include <string.h> /* strlen, memmove, ... */
 # include <stdarg.h> /* va_arg, va_end, ... */
 # include <assert.h> /* assert, static_assert, ... */
+# include <stddef.h> /* offsetof */
 # ifndef MLX_SWAP_INTERVAL
 #  define MLX_SWAP_INTERVAL 1
 # endif
 # ifndef MLX_BATCH_SIZE
-#  define MLX_BATCH_SIZE 12000
+#  define MLX_BATCH_SIZE 4096 /* Quads per batch */
+# endif
+# ifndef MLX_INSTANCED_MIN
+#  define MLX_INSTANCED_MIN 8 /* Instances in a row before drawing them instanced */
+# endif
+# ifndef MLX_RING_SIZE
+#  define MLX_RING_SIZE 4194304 /* Bytes of vertex data in flight */
+# endif
+# ifndef MLX_RING_SECTIONS
+#  define MLX_RING_SECTIONS 4 /* Fenced sections of the vertex ring */
+# endif
+# ifndef MLX_ATLAS_SIZE
+#  define MLX_ATLAS_SIZE 1024 /* Width and height of an atlas page */
+# endif
+# ifndef MLX_ATLAS_MAX
+#  define MLX_ATLAS_MAX 256 /* Images up to this size are packed into an atlas */
+# endif
+# define MLX_ARRAY_UNIT 15 /* Texture unit reserved for image groups, fixed by the shader */
+# ifndef MLX_STATS_QUERIES
+#  define MLX_STATS_QUERIES 4 /* GPU timer queries in flight */
+# endif
+# ifndef MLX_STATS_HISTORY
+#  define MLX_STATS_HISTORY 256 /* Frames in the frame time histogram */
+# endif
+# ifndef MLX_TRACE_SIZE
+#  define MLX_TRACE_SIZE 65536 /* Trace events kept, must be a power of two */
+# endif
+# ifndef MLX_STREAM_BUFFERS
+#  define MLX_STREAM_BUFFERS 3 /* Pixel buffers per streaming image */
+# endif
+# ifndef MLX_TILE_SIZE
+#  define MLX_TILE_SIZE 32 /* Rows per tile of the software backend */
+# endif
+# ifndef MLX_PARALLEL_TILE
+#  define MLX_PARALLEL_TILE 64 /* Default width and height of tiles of mlx_parallel_tiles */
+# endif
+# ifndef MLX_COMMAND_QUEUE
+#  define MLX_COMMAND_QUEUE 4096 /* Commands that can be posted per frame */
+# endif
+# ifndef MLX_SPAN_SIZE
+#  define MLX_SPAN_SIZE 256 /* Pixels sampled at once by transformed blits */
+# endif
+# ifndef MLX_READBACK_BUFFERS
+#  define MLX_READBACK_BUFFERS 3 /* Frames a framebuffer read may be in flight */
 # endif
 # define BPP sizeof(int32_t) /* Only support RGBA */
 # define GETLINE_BUFF 1280
@@ -75,16 +119,24 @@ extern int32_t mlx_settings[MLX_SETTINGS_MAX];
 
 //= Types =//
 
-// A single vertex, identical to the layout in the shader.
-typedef struct vertex
+/**
+ * A single quad, identical to the per-instance layout in the shader.
+ * 
+ * The shader expands it into its corners, so a quad costs 24 bytes instead
+ * of the 144 of six full vertices. Positions fit in 16 bits as quads that
+ * are entirely off screen are never drawn, the UV rect is normalized.
+ */
+typedef struct mlx_quad
 {
-	float	x;
-	float	y;
-	float	z;
-	float	u;
-	float	v;
-	int8_t	tex;
-}	vertex_t;
+	int16_t		x;
+	int16_t		y;
+	uint16_t	width;
+	uint16_t	height;
+	int32_t		z;
+	uint16_t	uv[4];
+	int8_t		tex;
+	int16_t		layer;
+}	mlx_quad_t;
 
 // Layout for linked list.
 typedef struct mlx_list
@@ -156,6 +208,7 @@ typedef struct mlx_hook
 {
 	void*	param;
 	void	(*func)(void*);
+	char*	name;
 }	mlx_hook_t;
 
 //= Rendering =//
@@ -164,28 +217,182 @@ typedef struct mlx_hook
  * such as the vertex array object, vertex buffer object &
  * the shader program. As well as hooks and the zdepth level.
  *
- * Additionally we represent draw calls with a linked list
- * queue that point to the image and the index of which instance.
+ * Additionally we represent draw calls with a contiguous array of
+ * entries that point to the image and the index of which instance.
  * Again, instances only carry xyz data, so coupled with the image it
- * lets us know where to draw a copy of the image.
+ * lets us know where to draw a copy of the image. The array is sorted
+ * in place by depth and simply walked front to back every frame.
  *
  * Texture contexts are kept in a struct alongside the capacity
  * of the array of instances, since the array is realloced like a vector.
  */
 
+// Draw call queue entry, the depth is cached for sorting.
+typedef struct draw_queue
+{
+	mlx_image_t*	image;
+	int32_t			instanceid;
+	int32_t			z;
+}	draw_queue_t;
+
+/**
+ * Streaming vertex buffer, written front to back and wrapped around.
+ * 
+ * The ring is split into sections, a fence is placed when writing leaves
+ * a section and waited on before writing enters it again. As long as the
+ * GPU keeps up that wait is free. Without persistent mapping the buffer is
+ * orphaned on wrap instead and the driver does the bookkeeping.
+ */
+typedef struct mlx_ring
+{
+	GLuint		buffer;
+	size_t		size;
+	size_t		offset;
+	size_t		pushed;
+	uint32_t	section;
+	GLsync		fences[MLX_RING_SECTIONS];
+	uint8_t*	mapping;
+}	mlx_ring_t;
+
+// Segment of the skyline, the packed images from x to x + width end at y.
+typedef struct mlx_skyline
+{
+	uint16_t	x;
+	uint16_t	y;
+	uint16_t	width;
+}	mlx_skyline_t;
+
+/**
+ * Atlas page, a shared texture small images are packed into.
+ * 
+ * Images are packed with a skyline, which can't give space back. Instead
+ * the page is flagged when an image leaves it and repacked from scratch.
+ */
+typedef struct mlx_atlas
+{
+	GLuint			texture;
+	struct mlx_ctx*	mlx;
+	uint32_t		count;
+	bool			repack;
+	uint32_t		segments;
+	mlx_skyline_t	skyline[MLX_ATLAS_SIZE + 1];
+}	mlx_atlas_t;
+
+/**
+ * Frame statistics, collected while a frame is running and published
+ * once it is done.
+ * 
+ * GPU timings come from a ring of timer queries, a query is only read
+ * back once it's available so the CPU never waits for it.
+ * 
+ * Draw calls are counted into render, which is the current frame unless
+ * a render thread draws the frames, it then counts into its own.
+ * 
+ * Whether a frame is timed, and with a query, is decided as it begins,
+ * so a hook toggling MLX_FRAME_STATS only takes effect on the next frame.
+ */
+typedef struct mlx_stats
+{
+	mlx_frame_stats_t	current;
+	mlx_frame_stats_t	last;
+	mlx_frame_stats_t*	render;
+	bool				active;
+	bool				querying;
+	double				start;
+	double				mark;
+	size_t				pushed;
+	GLuint				queries[MLX_STATS_QUERIES];
+	uint32_t			issued;
+	uint32_t			collected;
+	uint32_t			histogram[MLX_HISTOGRAM_SIZE];
+	uint8_t				history[MLX_STATS_HISTORY];
+	uint32_t			frames;
+}	mlx_stats_t;
+
+/**
+ * A read of the framebuffer into a pixel buffer, which is copied to
+ * its target once the GPU is done with it.
+ */
+typedef struct mlx_readback
+{
+	GLuint		buffer;
+	GLsync		fence;
+	size_t		capacity;
+	uint8_t*	target;
+	int32_t		width;
+	int32_t		height;
+	uint32_t	frames;
+}	mlx_readback_t;
+
+/**
+ * A row of samples taken from the pixels of an image, stepping through
+ * them in 16.16 fixed point. All samples are within the image.
+ */
+typedef struct mlx_span
+{
+	const uint8_t*	pixels;
+	uint32_t		width;
+	uint32_t		height;
+	int64_t			u;
+	int64_t			v;
+	int64_t			du;
+	int64_t			dv;
+}	mlx_span_t;
+
+// Kernels that work on rows of pixels, chosen for the CPU at startup.
+typedef struct mlx_kernels
+{
+	void	(*fill)(uint8_t* dst, uint32_t pixel, size_t count);
+	void	(*blit)(uint8_t* dst, const uint8_t* src, size_t count, mlx_blend_t mode);
+	void	(*bilinear)(uint8_t* dst, const mlx_span_t* span, size_t count);
+}	mlx_kernels_t;
+
+extern mlx_kernels_t mlx_kernels;
+
+// Trace of the render loop, only allocated while tracing, see mlx_trace.c.
+typedef struct mlx_trace	mlx_trace_t;
+
+// Framebuffer of the software backend, see mlx_software.c.
+typedef struct mlx_software	mlx_software_t;
+
+// Worker threads that run tasks in parallel, see mlx_pool.c.
+typedef struct mlx_pool	mlx_pool_t;
+typedef void (*mlx_task_t)(void* param, uint32_t index);
+
+// Lock-free queue of fixed size items, see mlx_queue.c.
+typedef struct mlx_queue	mlx_queue_t;
+
+// Change to an image posted by any thread, see mlx_commands.c.
+typedef struct mlx_command	mlx_command_t;
+
+// Tiles rendered in the background, see mlx_parallel.c.
+typedef struct mlx_progress	mlx_progress_t;
+
+// Render thread of the pipelined loop, see mlx_pipeline.c.
+typedef struct mlx_pipeline	mlx_pipeline_t;
+
 // MLX instance context.
 typedef struct mlx_ctx
 {
 	GLuint			vao;
-	GLuint			vbo;
+	GLuint			instance_vao;
+	GLuint			ebo;
+	mlx_ring_t		vertices;
 	GLuint			shaderprogram;
 
 	uint32_t		initialWidth;
 	uint32_t		initialHeight;
+	int32_t			viewWidth;
+	int32_t			viewHeight;
 
 	mlx_list_t*		hooks;
 	mlx_list_t*		images;
-	mlx_list_t*		render_queue;
+	mlx_list_t*		atlases;
+	draw_queue_t*	render_queue;
+	size_t			render_count;
+	size_t			render_capacity;
+	draw_queue_t*	sort_buffer;
+	size_t			sort_capacity;
 
 	mlx_scroll_t	scroll_hook;
 	mlx_mouse_t		mouse_hook;
@@ -194,24 +401,110 @@ typedef struct mlx_ctx
 	mlx_resize_t	resize_hook;
 	mlx_close_t		close_hook;
 
+	GLuint			fbo;
+	GLuint			fbo_color;
+	GLuint			fbo_depth;
+	int32_t			fbo_width;
+	int32_t			fbo_height;
+	mlx_readback_t	reads[MLX_READBACK_BUFFERS];
+	uint32_t		read_index;
+	uint8_t*		read_target;
+
+	mlx_software_t*	software;
+	mlx_pool_t*		pool;
+	_Atomic(mlx_queue_t*)	commands;
+	mlx_command_t*	held;
+	size_t			held_next;
+	size_t			held_count;
+	size_t			held_size;
+	mlx_pipeline_t*	pipeline;
+	mlx_stats_t		stats;
+	mlx_trace_t*	trace;
 	int32_t			zdepth;
 	int32_t			bound_textures[16];
 	int32_t			batch_size;
-	vertex_t		batch_vertices[MLX_BATCH_SIZE];
+	mlx_quad_t		batch_quads[MLX_BATCH_SIZE];
 }	mlx_ctx_t;
 
-// Draw call queue entry.
-typedef struct draw_queue
+// Region of an image in pixels, the max coordinates are exclusive.
+typedef struct mlx_rect
 {
-	mlx_image_t*	image;
-	int32_t			instanceid;
-}	draw_queue_t;
+	uint32_t	x0;
+	uint32_t	y0;
+	uint32_t	x1;
+	uint32_t	y1;
+}	mlx_rect_t;
+
+/**
+ * Ring of pixel buffer objects used to stream an image to its texture.
+ * 
+ * Each frame the pixels are copied into the next buffer of the ring from
+ * which the driver then updates the texture asynchronously. A fence per
+ * buffer tells us when the GPU is done with it so it can be reused.
+ * 
+ * If mapping is set, the image instead has a single persistently mapped
+ * buffer which is its pixel buffer, so there is nothing to copy at all.
+ */
+typedef struct mlx_stream
+{
+	GLuint		buffers[MLX_STREAM_BUFFERS];
+	GLsync		fences[MLX_STREAM_BUFFERS];
+	uint32_t	index;
+	uint8_t*	mapping;
+}	mlx_stream_t;
+
+/**
+ * Pixel buffers of an image written by another thread, see mlx_buffers.c.
+ * 
+ * The producer writes into the back buffer while the front one is being
+ * uploaded. Swapping exchanges the back buffer with the middle one, which
+ * is flagged as fresh, at the next frame the front is exchanged with it.
+ */
+typedef struct mlx_buffers
+{
+	uint8_t*			pixels[3];
+	_Atomic(uint32_t)	middle;
+	uint32_t			front;
+	uint32_t			back;
+}	mlx_buffers_t;
+
+// Texture array shared by a group of images, one layer each.
+typedef struct mlx_group
+{
+	GLuint		texture;
+	uint32_t	count;
+}	mlx_group_t;
 
-// Image context.
+/**
+ * Image context.
+ *
+ * The dirty rect is the region of pixels that has been modified since
+ * the last upload to the GPU. An empty rect has its min coordinates
+ * past its max ones, that way marking a region is a simple min/max.
+ *
+ * Images packed into an atlas share its texture, they sit at the given
+ * offset in it and the UV rect covers only their part. Images of a
+ * group share a texture array instead, each in its own layer.
+ *
+ * While tiles are rendered in the background, only the ones that are
+ * done are uploaded instead of the dirty rect. Buffered images are read
+ * from their front buffer instead of the pixels.
+ */
 typedef struct mlx_image_ctx
 {
-	GLuint	texture;
-	size_t	instances_capacity;
+	struct mlx_ctx*	mlx;
+	GLuint			texture;
+	size_t			instances_capacity;
+	mlx_rect_t		dirty;
+	mlx_stream_t*	stream;
+	mlx_atlas_t*	atlas;
+	uint32_t		atlas_x;
+	uint32_t		atlas_y;
+	uint16_t		uv[4];
+	mlx_group_t*	group;
+	uint32_t		layer;
+	mlx_progress_t*	progress;
+	mlx_buffers_t*	buffers;
 }	mlx_image_ctx_t;
 
 //= Functions =//
@@ -229,13 +522,17 @@ void mlx_lstclear(mlx_list_t** lst, void (*del)(void*));
 void mlx_lstadd_back(mlx_list_t** lst, mlx_list_t* new);
 void mlx_lstadd_front(mlx_list_t** lst, mlx_list_t* new);
 mlx_list_t* mlx_lstremove(mlx_list_t** lst, void* value, bool (*comp)(void*, void*));
-void mlx_sort_renderqueue(mlx_list_t** lst);
+
+//= Render Queue Functions =//
+
+void mlx_sort_renderqueue(mlx_ctx_t* mlx);
 
 //= Misc functions =//
 
 bool mlx_equal_image(void* lstcontent, void* value);
-bool mlx_equal_inst(void* lstcontent, void* value);
+bool mlx_equal_atlas(void* lstcontent, void* value);
 void mlx_draw_pixel(uint8_t* pixel, uint32_t color);
+void mlx_clear_dirty(mlx_image_t* img);
 
 //= Error/log Handling Functions =//
 
@@ -244,9 +541,103 @@ bool mlx_freen(int32_t count, ...);
 
 //= OpenGL Functions =//
 
-void mlx_update_matrix(const mlx_t* mlx, int32_t width, int32_t height);
-void mlx_draw_instance(mlx_ctx_t* mlx, mlx_image_t* img, mlx_instance_t* instance);
+void mlx_update_matrix(const mlx_t* mlx, int32_t width, int32_t height, int32_t zdepth);
+void mlx_draw_instance(mlx_ctx_t* mlx, mlx_image_t* img, const mlx_instance_t* instance);
+void mlx_draw_instances(mlx_ctx_t* mlx, mlx_image_t* img, const mlx_instance_t* instances, int32_t count);
+void mlx_draw_queue(mlx_ctx_t* mlx, const draw_queue_t* queue, const mlx_instance_t* snapshot, size_t count);
 void mlx_flush_batch(mlx_ctx_t* mlx);
+GLuint mlx_new_texture(uint32_t width, uint32_t height);
+void mlx_create_texture(mlx_image_t* img);
+void mlx_release_texture(mlx_image_t* img);
+void mlx_unshare_texture(mlx_image_t* img);
+mlx_image_t* mlx_create_image(mlx_t* mlx, uint32_t width, uint32_t height);
+size_t mlx_upload_image(mlx_image_t* img);
+size_t mlx_upload_rect(mlx_image_t* img, mlx_rect_t rect);
+void mlx_wait_sync(GLsync* sync);
+bool mlx_atlas_place(mlx_ctx_t* mlx, mlx_image_t* img);
+void mlx_atlas_release(mlx_image_t* img);
+void mlx_repack_atlases(mlx_ctx_t* mlx);
+void mlx_create_ring(mlx_ring_t* ring, size_t size);
+size_t mlx_ring_push(mlx_ring_t* ring, const void* data, size_t size, size_t align);
+bool mlx_create_stream(mlx_image_t* img);
+void mlx_delete_stream(mlx_image_t* img);
+void mlx_stream_image(mlx_image_t* img, mlx_rect_t dirty);
+bool mlx_resize_mapping(mlx_image_t* img, uint32_t nwidth, uint32_t nheight);
+void mlx_sync_streams(mlx_ctx_t* mlx);
+
+//= Framebuffer Functions =//
+
+bool mlx_create_offscreen(mlx_ctx_t* mlx, int32_t width, int32_t height);
+void mlx_resize_offscreen(mlx_ctx_t* mlx, int32_t width, int32_t height);
+void mlx_issue_read(mlx_ctx_t* mlx, uint8_t* target);
+void mlx_sync_reads(mlx_ctx_t* mlx, bool wait);
+
+//= Software Functions =//
+
+bool mlx_create_software(mlx_ctx_t* mlx, int32_t width, int32_t height);
+void mlx_render_software(mlx_ctx_t* mlx, int32_t width, int32_t height);
+void mlx_read_software(mlx_ctx_t* mlx, uint8_t* dst);
+void mlx_delete_software(mlx_ctx_t* mlx);
+
+//= Pixel Kernel Functions =//
+
+void mlx_init_kernels(void);
+
+//= Thread Pool Functions =//
+
+uint32_t mlx_cpu_count(void);
+uint32_t mlx_thread_count(void);
+mlx_pool_t* mlx_get_pool(mlx_ctx_t* mlx);
+mlx_pool_t* mlx_new_pool(uint32_t threads);
+void mlx_pool_run(mlx_pool_t* pool, mlx_task_t task, void* param, uint32_t count);
+void mlx_delete_pool(mlx_pool_t* pool);
+
+//= Queue Functions =//
+
+mlx_queue_t* mlx_new_queue(size_t capacity, size_t size);
+bool mlx_queue_push(mlx_queue_t* queue, const void* item);
+bool mlx_queue_pop(mlx_queue_t* queue, void* item);
+void mlx_delete_queue(mlx_queue_t* queue);
+
+//= Buffer Functions =//
+
+const uint8_t* mlx_front_pixels(const mlx_image_t* img);
+bool mlx_acquire_front(mlx_image_t* img);
+bool mlx_resize_buffers(mlx_image_t* img, size_t size);
+void mlx_delete_buffers(mlx_image_t* img);
+
+//= Command Functions =//
+
+void mlx_apply_commands(mlx_t* mlx);
+void mlx_drop_commands(mlx_ctx_t* mlx, const mlx_image_t* image);
+
+//= Progressive Functions =//
+
+bool mlx_progress_pending(const mlx_image_t* img);
+size_t mlx_upload_progress(mlx_image_t* img);
+void mlx_delete_progress(mlx_image_t* img);
+void mlx_reap_progress(mlx_ctx_t* mlx);
+
+//= Pipeline Functions =//
+
+bool mlx_create_pipeline(mlx_t* mlx);
+void mlx_submit_frame(mlx_t* mlx);
+size_t mlx_stage_rect(mlx_image_t* img, mlx_rect_t rect);
+void mlx_acquire_context(mlx_ctx_t* mlx);
+void mlx_release_context(mlx_ctx_t* mlx);
+void mlx_delete_pipeline(mlx_ctx_t* mlx);
+
+//= Stats Functions =//
+
+void mlx_stats_begin(mlx_ctx_t* mlx);
+void mlx_stats_phase(mlx_ctx_t* mlx, double* phase);
+void mlx_stats_end(mlx_ctx_t* mlx);
+
+//= Trace Functions =//
+
+double mlx_trace_begin(const mlx_ctx_t* mlx);
+void mlx_trace_end(mlx_ctx_t* mlx, const char* name, const void* id, double start, uint64_t value);
+void mlx_write_trace(mlx_ctx_t* mlx);
 
 // Utils Functions =//
 
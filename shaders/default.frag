@@ -2,6 +2,7 @@
 
 in vec2 TexCoord;
 flat in int TexIndex;
+flat in int Layer;
 
 out vec4 FragColor;
 
@@ -20,11 +21,15 @@ uniform sampler2D Texture11;
 uniform sampler2D Texture12;
 uniform sampler2D Texture13;
 uniform sampler2D Texture14;
-uniform sampler2D Texture15;
+uniform sampler2DArray TextureArray;
 
 void main()
 {
     vec4 outColor = vec4(1.0, 0.0, 0.0, 1.0);
+    if (TexIndex == 15) {
+        FragColor = texture(TextureArray, vec3(TexCoord, Layer));
+        return;
+    }
     switch (int(TexIndex)) {
         case 0: outColor = texture(Texture0, TexCoord); break;
         case 1: outColor = texture(Texture1, TexCoord); break;
@@ -41,7 +46,6 @@ void main()
         case 12: outColor = texture(Texture12, TexCoord); break;
         case 13: outColor = texture(Texture13, TexCoord); break;
         case 14: outColor = texture(Texture14, TexCoord); break;
-        case 15: outColor = texture(Texture15, TexCoord); break;
         default: outColor = vec4(1.0, 0.0, 0.0, 1.0); break;
     }
     FragColor = outColor;
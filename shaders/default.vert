@@ -1,17 +1,31 @@
 #version 330 core
 
-layout(location = 0) in vec3 aPos;
-layout(location = 1) in vec2 aTexCoord;
-layout(location = 2) in int aTexIndex;
+layout(location = 0) in ivec2 aPos;
+layout(location = 1) in int aDepth;
+layout(location = 2) in vec2 aSize;
+layout(location = 3) in vec4 aTexRect;
+layout(location = 4) in int aTexIndex;
+layout(location = 5) in int aLayer;
+layout(location = 6) in int aEnabled;
 
 out vec2 TexCoord;
 flat out int TexIndex;
+flat out int Layer;
 
 uniform mat4 ProjMatrix;
 
+const vec2 Corners[4] = vec2[4](
+	vec2(0.0, 0.0), vec2(1.0, 1.0), vec2(1.0, 0.0), vec2(0.0, 1.0)
+);
+
 void main()
 {
-	gl_Position = ProjMatrix * vec4(aPos, 1.0);
-	TexCoord = aTexCoord;
+	vec2 corner = Corners[gl_VertexID];
+	vec2 pos = vec2(aPos) + corner * aSize;
+	gl_Position = ProjMatrix * vec4(pos, float(aDepth), 1.0);
+	if (aEnabled == 0)
+		gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+	TexCoord = mix(aTexRect.xy, aTexRect.zw, corner);
 	TexIndex = aTexIndex;
+	Layer = aLayer;
 }
@@ -6,7 +6,7 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2022/02/22 12:01:37 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/06/27 19:53:36 by lde-la-h      ########   odam.nl         */
+/*   Updated: 2026/10/18 06:27:26 by W2Wizard      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -39,6 +39,7 @@ static void mlx_draw_char(mlx_image_t* image, int32_t texoffset, int32_t imgoffs
 		pixeli = image->pixels + ((y * image->width + imgoffset) * BPP);
 		memcpy(pixeli, pixelx, FONT_WIDTH * BPP);
 	}
+	mlx_image_mark_dirty(image, imgoffset, 0, FONT_WIDTH, FONT_HEIGHT);
 }
 
 //= Public =//
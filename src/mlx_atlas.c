@@ -0,0 +1,262 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_atlas.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:40:10 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 06:47:02 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+//= Private =//
+
+// Images are padded so neighbours never bleed into each other.
+#define MLX_ATLAS_PADDING 1
+
+// Converts a position in the page to a normalized 16 bit texture coordinate.
+#define MLX_ATLAS_UV(pos) ((uint16_t)(((pos) * UINT16_MAX + MLX_ATLAS_SIZE / 2) / MLX_ATLAS_SIZE))
+
+/**
+ * Finds the height at which a rect would rest on the skyline if its left
+ * edge is put at the start of the given segment.
+ * 
+ * @return False if the rect doesn't fit there.
+ */
+static bool mlx_skyline_fit(const mlx_atlas_t* page, uint32_t index, uint32_t width, uint32_t height, uint32_t* y)
+{
+	if (page->skyline[index].x + width > MLX_ATLAS_SIZE)
+		return (false);
+
+	uint32_t top = 0;
+	for (uint32_t left = width; left > 0; index++)
+	{
+		const mlx_skyline_t* segment = &page->skyline[index];
+
+		top = segment->y > top ? segment->y : top;
+		if (top + height > MLX_ATLAS_SIZE)
+			return (false);
+		left -= segment->width < left ? segment->width : left;
+	}
+	*y = top;
+	return (true);
+}
+
+/**
+ * Packs a rect into the page at the lowest spot on the skyline,
+ * on ties the leftmost one is taken.
+ */
+static bool mlx_skyline_insert(mlx_atlas_t* page, uint32_t width, uint32_t height, uint32_t* x, uint32_t* y)
+{
+	uint32_t best = UINT32_MAX;
+	uint32_t besty = UINT32_MAX;
+	for (uint32_t i = 0; i < page->segments; i++)
+	{
+		uint32_t top;
+		if (mlx_skyline_fit(page, i, width, height, &top) && top < besty)
+		{
+			best = i;
+			besty = top;
+		}
+	}
+	if (best == UINT32_MAX)
+		return (false);
+
+	mlx_skyline_t* const skyline = page->skyline;
+	*x = skyline[best].x;
+	*y = besty;
+
+	// Raise the skyline where the rect was put, cutting away what it covers.
+	memmove(&skyline[best + 1], &skyline[best], (page->segments++ - best) * sizeof(mlx_skyline_t));
+	skyline[best] = (mlx_skyline_t){*x, besty + height, width};
+	const uint32_t end = *x + width;
+	for (uint32_t i = best + 1; i < page->segments && skyline[i].x < end;)
+	{
+		const uint32_t cut = end - skyline[i].x;
+		if (cut < skyline[i].width)
+		{
+			skyline[i].x += cut;
+			skyline[i].width -= cut;
+			break;
+		}
+		memmove(&skyline[i], &skyline[i + 1], (--page->segments - i) * sizeof(mlx_skyline_t));
+	}
+
+	// Merge neighbours at the same height.
+	for (uint32_t i = 0; i + 1 < page->segments;)
+	{
+		if (skyline[i].y != skyline[i + 1].y)
+		{
+			i++;
+			continue;
+		}
+		skyline[i].width += skyline[i + 1].width;
+		memmove(&skyline[i + 1], &skyline[i + 2], (--page->segments - i - 1) * sizeof(mlx_skyline_t));
+	}
+	return (true);
+}
+
+static bool mlx_atlas_insert(mlx_atlas_t* page, mlx_image_t* img)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+
+	uint32_t x, y;
+	if (!mlx_skyline_insert(page, img->width + MLX_ATLAS_PADDING, img->height + MLX_ATLAS_PADDING, &x, &y))
+		return (false);
+
+	page->count++;
+	imgctx->texture = page->texture;
+	imgctx->atlas = page;
+	imgctx->atlas_x = x;
+	imgctx->atlas_y = y;
+	imgctx->uv[0] = MLX_ATLAS_UV(x);
+	imgctx->uv[1] = MLX_ATLAS_UV(y);
+	imgctx->uv[2] = MLX_ATLAS_UV(x + img->width);
+	imgctx->uv[3] = MLX_ATLAS_UV(y + img->height);
+
+	// Whatever was in this spot before belongs to someone else.
+	imgctx->dirty = (mlx_rect_t){0, 0, img->width, img->height};
+	return (true);
+}
+
+static void mlx_clear_skyline(mlx_atlas_t* page)
+{
+	page->segments = 1;
+	page->skyline[0] = (mlx_skyline_t){0, 0, MLX_ATLAS_SIZE};
+}
+
+static mlx_atlas_t* mlx_new_atlas(mlx_ctx_t* mlx)
+{
+	mlx_atlas_t* page = calloc(1, sizeof(mlx_atlas_t));
+	mlx_list_t* entry = NULL;
+	if (!page || !(entry = mlx_lstnew(page)))
+		return (mlx_freen(2, page, entry), NULL);
+
+	page->mlx = mlx;
+	page->texture = mlx_new_texture(MLX_ATLAS_SIZE, MLX_ATLAS_SIZE);
+	mlx_clear_skyline(page);
+	mlx_lstadd_back(&mlx->atlases, entry);
+	return (page);
+}
+
+static void mlx_delete_atlas(mlx_atlas_t* page)
+{
+	mlx_list_t* entry = mlx_lstremove(&page->mlx->atlases, page, &mlx_equal_atlas);
+
+	glDeleteTextures(1, &page->texture);
+	mlx_freen(2, entry, page);
+}
+
+// Tallest first, which is what keeps a skyline tight.
+static int mlx_compare_height(const void* a, const void* b)
+{
+	const mlx_image_t* imga = *(mlx_image_t* const*)a;
+	const mlx_image_t* imgb = *(mlx_image_t* const*)b;
+
+	return ((int32_t)imgb->height - (int32_t)imga->height);
+}
+
+/**
+ * Packs the images left on the page again from scratch, reclaiming the
+ * space of the images that left it. In the rare case an image no longer
+ * fits it simply gets its own texture.
+ */
+static void mlx_repack_atlas(mlx_atlas_t* page)
+{
+	mlx_image_t** images;
+	if (!(images = malloc(page->count * sizeof(mlx_image_t*))))
+		return;
+
+	uint32_t count = 0;
+	for (mlx_list_t* imglst = page->mlx->images; imglst; imglst = imglst->next)
+	{
+		if (((mlx_image_ctx_t*)((mlx_image_t*)imglst->content)->context)->atlas == page)
+			images[count++] = imglst->content;
+	}
+	MLX_ASSERT(count == page->count, "Atlas lost track of its images");
+	qsort(images, count, sizeof(mlx_image_t*), &mlx_compare_height);
+
+	page->count = 0;
+	page->repack = false;
+	mlx_clear_skyline(page);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (!mlx_atlas_insert(page, images[i]))
+			mlx_create_texture(images[i]);
+	}
+	free(images);
+}
+
+/**
+ * Packs a small image into one of the atlas pages, making a new page
+ * if none of them has room left.
+ * 
+ * @param mlx The MLX instance context.
+ * @param img The image, without a texture.
+ * @return False if the image should get a texture of its own instead.
+ */
+bool mlx_atlas_place(mlx_ctx_t* mlx, mlx_image_t* img)
+{
+	if (img->width > MLX_ATLAS_MAX || img->height > MLX_ATLAS_MAX)
+		return (false);
+
+	for (mlx_list_t* lst = mlx->atlases; lst; lst = lst->next)
+	{
+		mlx_atlas_t* const page = lst->content;
+		if (mlx_atlas_insert(page, img))
+			return (true);
+
+		// Space left behind by other images might be enough.
+		if (page->repack)
+		{
+			mlx_repack_atlas(page);
+			if (mlx_atlas_insert(page, img))
+				return (true);
+		}
+	}
+
+	mlx_atlas_t* page;
+	if (!(page = mlx_new_atlas(mlx)))
+		return (false);
+	return (mlx_atlas_insert(page, img));
+}
+
+/**
+ * Takes an image off its atlas page, its spot is reclaimed once the
+ * page is repacked.
+ */
+void mlx_atlas_release(mlx_image_t* img)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+
+	if (!imgctx->atlas)
+		return;
+	imgctx->atlas->count--;
+	imgctx->atlas->repack = true;
+	imgctx->atlas = NULL;
+	imgctx->texture = 0;
+}
+
+/**
+ * Repacks the pages images have left since the previous frame,
+ * pages that ended up empty are deleted instead.
+ */
+void mlx_repack_atlases(mlx_ctx_t* mlx)
+{
+	mlx_list_t* lst = mlx->atlases;
+	while (lst)
+	{
+		mlx_atlas_t* const page = lst->content;
+
+		lst = lst->next;
+		if (!page->repack)
+			continue;
+		if (page->count == 0)
+			mlx_delete_atlas(page);
+		else
+			mlx_repack_atlas(page);
+	}
+}
@@ -0,0 +1,108 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_buffer.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:37:09 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:19:20 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+static_assert(MLX_RING_SIZE / MLX_RING_SECTIONS % 8 == 0, "MLX_RING_SIZE must split into sections of a multiple of 8 bytes");
+
+//= Private =//
+
+/**
+ * Creates the storage of the ring. Where supported it is mapped once and
+ * written to directly for as long as it lives.
+ * 
+ * @param ring The ring to create.
+ * @param size The size of the ring in bytes.
+ */
+void mlx_create_ring(mlx_ring_t* ring, size_t size)
+{
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	memset(ring, 0, sizeof(mlx_ring_t));
+	ring->size = size;
+	glGenBuffers(1, &ring->buffer);
+	glBindBuffer(GL_ARRAY_BUFFER, ring->buffer);
+	if (GLAD_GL_VERSION_4_4)
+	{
+		glBufferStorage(GL_ARRAY_BUFFER, size, NULL, flags);
+		if ((ring->mapping = glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags)))
+			return;
+
+		// Immutable storage can't be re-specified, so start over.
+		glDeleteBuffers(1, &ring->buffer);
+		glGenBuffers(1, &ring->buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, ring->buffer);
+	}
+	glBufferData(GL_ARRAY_BUFFER, size, NULL, GL_STREAM_DRAW);
+}
+
+/**
+ * Fences the section of the ring that writing is leaving and waits for
+ * the GPU to be done with the next one.
+ */
+static void mlx_ring_advance(mlx_ring_t* ring, uint32_t section)
+{
+	if (!ring->mapping)
+	{
+		ring->section = section;
+		return;
+	}
+	mlx_wait_sync(&ring->fences[ring->section]);
+	ring->fences[ring->section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	ring->section = section;
+	mlx_wait_sync(&ring->fences[section]);
+}
+
+/**
+ * Appends data to the ring, to be drawn from right after.
+ * 
+ * A push never straddles two sections. The fence of a section is placed
+ * when the next push leaves it, after the draw reading its last push, so
+ * that draw has to be the last one reading from it. Starting a section
+ * skips the alignment, its start is already aligned for any attribute.
+ * 
+ * @param ring The ring to write to.
+ * @param data The data to write.
+ * @param size The size of the data in bytes, at most the size of a section.
+ * @param align The alignment of the offset, e.g the size of a vertex.
+ * @return The offset of the data in the buffer.
+ */
+size_t mlx_ring_push(mlx_ring_t* ring, const void* data, size_t size, size_t align)
+{
+	const size_t section_size = ring->size / MLX_RING_SECTIONS;
+	size_t offset = (ring->offset + align - 1) / align * align;
+
+	MLX_ASSERT(size <= section_size, "Data does not fit in a section of the ring");
+	if (offset + size > (ring->section + 1) * section_size)
+	{
+		const uint32_t next = (ring->section + 1) % MLX_RING_SECTIONS;
+
+		offset = next * section_size;
+		mlx_ring_advance(ring, next);
+		if (next == 0 && !ring->mapping)
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, ring->buffer);
+			glBufferData(GL_ARRAY_BUFFER, ring->size, NULL, GL_STREAM_DRAW);
+		}
+	}
+
+	if (ring->mapping)
+		memcpy(ring->mapping + offset, data, size);
+	else
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, ring->buffer);
+		glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+	}
+	ring->offset = offset + size;
+	ring->pushed += size;
+	return (offset);
+}
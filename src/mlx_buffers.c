@@ -0,0 +1,142 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_buffers.c                                      :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:23:25 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 07:23:25 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+#include <stdatomic.h>
+
+//= Private =//
+
+/**
+ * Triple buffering: with only a front and a back buffer the producer would
+ * get the buffer that is still being uploaded back after a swap. The third
+ * one sits in the middle, so both sides always have a buffer to themselves.
+ */
+#define MLX_BUFFER_FRESH 4
+#define MLX_BUFFER_INDEX 3
+
+/**
+ * Returns the pixels of an image as they should be drawn, for buffered
+ * images those are the last ones that were published.
+ */
+const uint8_t* mlx_front_pixels(const mlx_image_t* img)
+{
+	const mlx_buffers_t* buffers = ((mlx_image_ctx_t*)img->context)->buffers;
+
+	return (buffers ? buffers->pixels[buffers->front] : img->pixels);
+}
+
+/**
+ * Takes the buffer published by the last swap as the front buffer, the
+ * whole image is marked as modified as nobody could tell us what changed.
+ * 
+ * @return Whether a new buffer was published since the last frame.
+ */
+bool mlx_acquire_front(mlx_image_t* img)
+{
+	mlx_buffers_t* const buffers = ((mlx_image_ctx_t*)img->context)->buffers;
+
+	if (!buffers || !(atomic_load_explicit(&buffers->middle, memory_order_relaxed) & MLX_BUFFER_FRESH))
+		return (false);
+	const uint32_t middle = atomic_exchange_explicit(&buffers->middle, buffers->front, memory_order_acq_rel);
+	buffers->front = middle & MLX_BUFFER_INDEX;
+	mlx_image_mark_dirty(img, 0, 0, img->width, img->height);
+	return (true);
+}
+
+/**
+ * Resizes every buffer of a buffered image, like realloc the previous
+ * data is copied over.
+ * 
+ * @param size The new size of a buffer in bytes.
+ */
+bool mlx_resize_buffers(mlx_image_t* img, size_t size)
+{
+	mlx_buffers_t* const buffers = ((mlx_image_ctx_t*)img->context)->buffers;
+
+	for (uint32_t i = 0; i < 3; i++)
+	{
+		uint8_t* tempbuff;
+		if (!(tempbuff = realloc(buffers->pixels[i], size)))
+			return (mlx_error(MLX_MEMFAIL));
+		buffers->pixels[i] = tempbuff;
+	}
+	img->pixels = buffers->pixels[buffers->back];
+	return (true);
+}
+
+void mlx_delete_buffers(mlx_image_t* img)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+	mlx_buffers_t* const buffers = imgctx->buffers;
+
+	if (!buffers)
+		return;
+	mlx_freen(4, buffers->pixels[0], buffers->pixels[1], buffers->pixels[2], buffers);
+	imgctx->buffers = NULL;
+	img->pixels = NULL;
+}
+
+//= Public =//
+
+bool mlx_set_image_buffering(mlx_image_t* image, bool enable)
+{
+	MLX_NONNULL(image);
+
+	mlx_image_ctx_t* const imgctx = image->context;
+	if (!imgctx->buffers == !enable)
+		return (true);
+
+	// Keep the pixels last published, the others go.
+	if (!enable)
+	{
+		mlx_buffers_t* const buffers = imgctx->buffers;
+		mlx_acquire_front(image);
+		uint8_t* const pixels = buffers->pixels[buffers->front];
+		buffers->pixels[buffers->front] = NULL;
+		mlx_delete_buffers(image);
+		image->pixels = pixels;
+		mlx_image_mark_dirty(image, 0, 0, image->width, image->height);
+		return (true);
+	}
+
+	// Streaming swaps the pixels for its own, only one of them can.
+	if (!mlx_set_image_streaming(image, false))
+		return (false);
+
+	const size_t size = image->width * image->height * BPP;
+	mlx_buffers_t* buffers;
+	if (!(buffers = calloc(1, sizeof(mlx_buffers_t))))
+		return (mlx_error(MLX_MEMFAIL));
+	if (!(buffers->pixels[1] = malloc(size)) || !(buffers->pixels[2] = malloc(size)))
+		return (mlx_freen(3, buffers->pixels[1], buffers->pixels[2], buffers), mlx_error(MLX_MEMFAIL));
+
+	memcpy(buffers->pixels[1], image->pixels, size);
+	memcpy(buffers->pixels[2], image->pixels, size);
+	buffers->pixels[0] = image->pixels;
+	buffers->back = 0;
+	buffers->front = 1;
+	atomic_init(&buffers->middle, 2);
+	imgctx->buffers = buffers;
+	return (true);
+}
+
+void mlx_image_swap(mlx_image_t* image)
+{
+	MLX_NONNULL(image);
+
+	mlx_buffers_t* const buffers = ((mlx_image_ctx_t*)image->context)->buffers;
+	MLX_ASSERT(buffers, "Image is not buffered");
+
+	const uint32_t middle = atomic_exchange_explicit(&buffers->middle, buffers->back | MLX_BUFFER_FRESH, memory_order_acq_rel);
+	buffers->back = middle & MLX_BUFFER_INDEX;
+	image->pixels = buffers->pixels[buffers->back];
+}
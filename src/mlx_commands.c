@@ -0,0 +1,199 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_commands.c                                     :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:26:42 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:21:26 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+#include <stdatomic.h>
+
+//= Private =//
+
+typedef enum mlx_command_type
+{
+	MLX_COMMAND_MOVE,
+	MLX_COMMAND_DEPTH,
+	MLX_COMMAND_ENABLE,
+	MLX_COMMAND_INSTANCE,
+	MLX_COMMAND_DELETE,
+}	mlx_command_type_t;
+
+/**
+ * A change to an image or one of its instances, posted by any thread and
+ * applied by the main thread at the start of the next frame.
+ * 
+ * The X value doubles as the depth or enabled state.
+ */
+struct mlx_command
+{
+	mlx_command_type_t	type;
+	mlx_image_t*		image;
+	int32_t				instance;
+	int32_t				x;
+	int32_t				y;
+};
+
+/**
+ * Returns the command queue, created by whichever thread posts first.
+ * Threads that lose the race to create it throw theirs away.
+ */
+static mlx_queue_t* mlx_get_commands(mlx_ctx_t* mlx)
+{
+	mlx_queue_t* queue = atomic_load_explicit(&mlx->commands, memory_order_acquire);
+	if (queue)
+		return (queue);
+
+	mlx_queue_t* created;
+	if (!(created = mlx_new_queue(MLX_COMMAND_QUEUE, sizeof(mlx_command_t))))
+		return (NULL);
+	if (atomic_compare_exchange_strong_explicit(&mlx->commands, &queue, created, memory_order_acq_rel, memory_order_acquire))
+		return (created);
+	mlx_delete_queue(created);
+	return (queue);
+}
+
+static bool mlx_post(mlx_t* mlx, mlx_command_t command)
+{
+	MLX_NONNULL(mlx);
+	MLX_NONNULL(command.image);
+
+	mlx_queue_t* queue;
+	if (!(queue = mlx_get_commands(mlx->context)))
+		return (false);
+	return (mlx_queue_push(queue, &command));
+}
+
+static void mlx_apply_command(mlx_t* mlx, const mlx_command_t* command)
+{
+	mlx_image_t* const image = command->image;
+
+	if (command->type == MLX_COMMAND_INSTANCE)
+		return ((void)mlx_image_to_window(mlx, image, command->x, command->y));
+	if (command->type == MLX_COMMAND_DELETE)
+		return (mlx_delete_image(mlx, image));
+
+	const bool valid = command->instance >= 0 && command->instance < image->count;
+	MLX_ASSERT(valid, "Instance index out of bounds");
+	if (!valid)
+		return;
+
+	mlx_instance_t* const instance = &image->instances[command->instance];
+	switch (command->type)
+	{
+		case MLX_COMMAND_MOVE:
+			instance->x = command->x;
+			instance->y = command->y;
+			break;
+		case MLX_COMMAND_DEPTH:
+			mlx_set_instance_depth(instance, command->x);
+			break;
+		case MLX_COMMAND_ENABLE:
+			instance->enabled = command->x;
+			break;
+		default:
+			break;
+	}
+}
+
+// Makes room for one more held command.
+static bool mlx_grow_held(mlx_ctx_t* mlx)
+{
+	if (mlx->held_count < mlx->held_size)
+		return (true);
+
+	const size_t size = mlx->held_size ? mlx->held_size * 2 : MLX_COMMAND_QUEUE;
+	mlx_command_t* held;
+	if (!(held = realloc(mlx->held, size * sizeof(mlx_command_t))))
+		return (mlx_error(MLX_MEMFAIL));
+	mlx->held = held;
+	mlx->held_size = size;
+	return (true);
+}
+
+/**
+ * Drops the commands about an image that is being deleted, which were
+ * posted before but not applied yet. The queue is drained into the held
+ * commands, which are applied before anything that is posted later.
+ */
+void mlx_drop_commands(mlx_ctx_t* mlx, const mlx_image_t* image)
+{
+	size_t count = 0;
+	for (size_t i = mlx->held_next; i < mlx->held_count; i++)
+	{
+		if (mlx->held[i].image != image)
+			mlx->held[count++] = mlx->held[i];
+	}
+	mlx->held_next = 0;
+	mlx->held_count = count;
+
+	mlx_queue_t* const queue = atomic_load_explicit(&mlx->commands, memory_order_acquire);
+	mlx_command_t command;
+	while (queue && mlx_grow_held(mlx) && mlx_queue_pop(queue, &command))
+	{
+		if (command.image != image)
+			mlx->held[mlx->held_count++] = command;
+	}
+}
+
+/**
+ * Applies the commands posted since the last frame, in the order they
+ * were posted. At most a queue worth of them, so threads that keep on
+ * posting can't hold up the frame.
+ */
+void mlx_apply_commands(mlx_t* mlx)
+{
+	mlx_ctx_t* const mlxctx = mlx->context;
+	mlx_queue_t* const queue = atomic_load_explicit(&mlxctx->commands, memory_order_acquire);
+	if (!queue)
+		return;
+
+	const double start = mlx_trace_begin(mlxctx);
+	mlx_command_t command;
+	uint64_t count = 0;
+	while (count < MLX_COMMAND_QUEUE)
+	{
+		if (mlxctx->held_next < mlxctx->held_count)
+			command = mlxctx->held[mlxctx->held_next++];
+		else if (!mlx_queue_pop(queue, &command))
+			break;
+		mlx_apply_command(mlx, &command);
+		count++;
+	}
+	if (mlxctx->held_next == mlxctx->held_count)
+		mlxctx->held_next = mlxctx->held_count = 0;
+	if (count > 0)
+		mlx_trace_end(mlxctx, "commands", queue, start, count);
+}
+
+//= Public =//
+
+bool mlx_post_instance_move(mlx_t* mlx, mlx_image_t* image, int32_t instance, int32_t x, int32_t y)
+{
+	return (mlx_post(mlx, (mlx_command_t){MLX_COMMAND_MOVE, image, instance, x, y}));
+}
+
+bool mlx_post_instance_depth(mlx_t* mlx, mlx_image_t* image, int32_t instance, int32_t zdepth)
+{
+	return (mlx_post(mlx, (mlx_command_t){MLX_COMMAND_DEPTH, image, instance, zdepth, 0}));
+}
+
+bool mlx_post_instance_enabled(mlx_t* mlx, mlx_image_t* image, int32_t instance, bool enabled)
+{
+	return (mlx_post(mlx, (mlx_command_t){MLX_COMMAND_ENABLE, image, instance, enabled, 0}));
+}
+
+bool mlx_post_image_to_window(mlx_t* mlx, mlx_image_t* image, int32_t x, int32_t y)
+{
+	return (mlx_post(mlx, (mlx_command_t){MLX_COMMAND_INSTANCE, image, -1, x, y}));
+}
+
+bool mlx_post_delete_image(mlx_t* mlx, mlx_image_t* image)
+{
+	return (mlx_post(mlx, (mlx_command_t){MLX_COMMAND_DELETE, image, -1, 0, 0}));
+}
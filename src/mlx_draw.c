@@ -0,0 +1,180 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_draw.c                                         :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:02:01 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 07:08:35 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+//= Private =//
+
+// A rectangle copied from a source image to a destination image.
+typedef struct mlx_copy
+{
+	int64_t	x;
+	int64_t	y;
+	int64_t	width;
+	int64_t	height;
+	int64_t	sx;
+	int64_t	sy;
+}	mlx_copy_t;
+
+// Clips a rectangle to the bounds of an area, false if nothing is left.
+static bool mlx_clip_rect(uint32_t bound_w, uint32_t bound_h, int64_t* x, int64_t* y, int64_t* width, int64_t* height)
+{
+	if (*x < 0)
+	{
+		*width += *x;
+		*x = 0;
+	}
+	if (*y < 0)
+	{
+		*height += *y;
+		*y = 0;
+	}
+	if (*x + *width > bound_w)
+		*width = bound_w - *x;
+	if (*y + *height > bound_h)
+		*height = bound_h - *y;
+	return (*width > 0 && *height > 0);
+}
+
+// The color in the byte order of the pixels.
+static uint32_t mlx_pixel_of(uint32_t color)
+{
+	uint32_t pixel;
+
+	mlx_draw_pixel((uint8_t*)&pixel, color);
+	return (pixel);
+}
+
+/**
+ * Clips the rectangle of a copy to both the source and destination,
+ * moving the source along with the destination and the other way around.
+ */
+static bool mlx_clip_copy(const mlx_image_t* dst, mlx_copy_t* copy, uint32_t src_w, uint32_t src_h)
+{
+	const int64_t dx = copy->sx - copy->x;
+	const int64_t dy = copy->sy - copy->y;
+
+	if (!mlx_clip_rect(src_w, src_h, &copy->sx, &copy->sy, &copy->width, &copy->height))
+		return (false);
+	copy->x = copy->sx - dx;
+	copy->y = copy->sy - dy;
+	if (!mlx_clip_rect(dst->width, dst->height, &copy->x, &copy->y, &copy->width, &copy->height))
+		return (false);
+	copy->sx = copy->x + dx;
+	copy->sy = copy->y + dy;
+	return (true);
+}
+
+// Blends the pixels of a source, src_w pixels wide, onto an image.
+static void mlx_blit(mlx_image_t* dst, mlx_copy_t copy, const uint8_t* src, uint32_t src_w, uint32_t src_h, mlx_blend_t mode)
+{
+	MLX_ASSERT(mode < MLX_BLEND_MAX, "Invalid blend mode");
+	MLX_ASSERT(src != dst->pixels, "Can't blend an image onto itself");
+
+	if (!mlx_clip_copy(dst, &copy, src_w, src_h))
+		return;
+
+	for (int64_t row = 0; row < copy.height; row++)
+	{
+		mlx_kernels.blit(&dst->pixels[((copy.y + row) * dst->width + copy.x) * BPP], \
+			&src[((copy.sy + row) * src_w + copy.sx) * BPP], copy.width, mode);
+	}
+	mlx_image_mark_dirty(dst, copy.x, copy.y, copy.width, copy.height);
+}
+
+//= Public =//
+
+void mlx_fill_rect(mlx_image_t* image, int32_t x, int32_t y, uint32_t width, uint32_t height, uint32_t color)
+{
+	MLX_NONNULL(image);
+
+	int64_t rx = x, ry = y, rw = width, rh = height;
+	if (!mlx_clip_rect(image->width, image->height, &rx, &ry, &rw, &rh))
+		return;
+
+	const uint32_t pixel = mlx_pixel_of(color);
+	for (int64_t row = ry; row < ry + rh; row++)
+		mlx_kernels.fill(&image->pixels[(row * image->width + rx) * BPP], pixel, rw);
+	mlx_image_mark_dirty(image, rx, ry, rw, rh);
+}
+
+void mlx_draw_hline(mlx_image_t* image, int32_t x, int32_t y, uint32_t length, uint32_t color)
+{
+	mlx_fill_rect(image, x, y, length, 1, color);
+}
+
+void mlx_draw_vline(mlx_image_t* image, int32_t x, int32_t y, uint32_t length, uint32_t color)
+{
+	MLX_NONNULL(image);
+
+	int64_t rx = x, ry = y, rw = 1, rh = length;
+	if (!mlx_clip_rect(image->width, image->height, &rx, &ry, &rw, &rh))
+		return;
+
+	const uint32_t pixel = mlx_pixel_of(color);
+	uint8_t* dst = &image->pixels[(ry * image->width + rx) * BPP];
+	for (int64_t i = 0; i < rh; i++, dst += image->width * BPP)
+		memcpy(dst, &pixel, BPP);
+	mlx_image_mark_dirty(image, rx, ry, rw, rh);
+}
+
+void mlx_clear_image(mlx_image_t* image, uint32_t color)
+{
+	MLX_NONNULL(image);
+
+	mlx_kernels.fill(image->pixels, mlx_pixel_of(color), (size_t)image->width * image->height);
+	mlx_image_mark_dirty(image, 0, 0, image->width, image->height);
+}
+
+void mlx_copy_rect(mlx_image_t* dst, int32_t x, int32_t y, const mlx_image_t* src, int32_t sx, int32_t sy, uint32_t width, uint32_t height)
+{
+	MLX_NONNULL(dst);
+	MLX_NONNULL(src);
+
+	mlx_copy_t copy = {x, y, width, height, sx, sy};
+	if (!mlx_clip_copy(dst, &copy, src->width, src->height))
+		return;
+
+	// Copying within the same image has to go the other way when moving down.
+	const bool reverse = dst == src && copy.y > copy.sy;
+	for (int64_t i = 0; i < copy.height; i++)
+	{
+		const int64_t row = reverse ? copy.height - 1 - i : i;
+		memmove(&dst->pixels[((copy.y + row) * dst->width + copy.x) * BPP], \
+			&src->pixels[((copy.sy + row) * src->width + copy.sx) * BPP], copy.width * BPP);
+	}
+	mlx_image_mark_dirty(dst, copy.x, copy.y, copy.width, copy.height);
+}
+
+void mlx_blend_rect(mlx_image_t* dst, int32_t x, int32_t y, const mlx_image_t* src, int32_t sx, int32_t sy, uint32_t width, uint32_t height)
+{
+	MLX_NONNULL(dst);
+	MLX_NONNULL(src);
+
+	mlx_blit(dst, (mlx_copy_t){x, y, width, height, sx, sy}, src->pixels, src->width, src->height, MLX_BLEND_ALPHA);
+}
+
+void mlx_blit_image(mlx_image_t* dst, const mlx_image_t* src, int32_t x, int32_t y, mlx_blend_t mode)
+{
+	MLX_NONNULL(dst);
+	MLX_NONNULL(src);
+
+	mlx_blit(dst, (mlx_copy_t){x, y, src->width, src->height, 0, 0}, src->pixels, src->width, src->height, mode);
+}
+
+void mlx_blit_texture(mlx_image_t* image, const mlx_texture_t* texture, int32_t x, int32_t y, mlx_blend_t mode)
+{
+	MLX_NONNULL(image);
+	MLX_NONNULL(texture);
+
+	mlx_blit(image, (mlx_copy_t){x, y, texture->width, texture->height, 0, 0}, texture->pixels, texture->width, texture->height, mode);
+}
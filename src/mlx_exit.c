@@ -6,7 +6,7 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2021/12/28 02:43:22 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/11/26 14:23:55 by jvan-hal      ########   odam.nl         */
+/*   Updated: 2026/10/18 08:21:26 by W2Wizard      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -17,8 +17,20 @@
 static void mlx_free_image(void* content)
 {
 	mlx_image_t* img = content;
+	mlx_stream_t* stream = ((mlx_image_ctx_t*)img->context)->stream;
 
-	mlx_freen(4, img->context, img->pixels, img->instances, img);
+	// The GL objects, including mapped pixels, are already gone with the context.
+	if (stream && stream->mapping)
+		img->pixels = NULL;
+	mlx_delete_buffers(img);
+	mlx_freen(5, stream, img->context, img->pixels, img->instances, img);
+}
+
+static void mlx_free_hook(void* content)
+{
+	mlx_hook_t* hook = content;
+
+	mlx_freen(2, hook->name, hook);
 }
 
 //= Public =//
@@ -39,9 +51,22 @@ void mlx_terminate(mlx_t* mlx)
 
 	mlx_ctx_t *const mlxctx = mlx->context;
 
+	// The render thread finishes its frame and gives the context back.
+	mlx_delete_pipeline(mlxctx);
+
+	// Tiles rendered in the background might write into mapped pixels.
+	for (mlx_list_t* entry = mlxctx->images; entry; entry = entry->next)
+		mlx_delete_progress(entry->content);
+	if (mlx->window)
+		mlx_sync_reads(mlxctx, true);
 	glfwTerminate();
-	mlx_lstclear((mlx_list_t**)(&mlxctx->hooks), &free);
-	mlx_lstclear((mlx_list_t**)(&mlxctx->render_queue), &free);
+	mlx_delete_software(mlxctx);
+	mlx_delete_pool(mlxctx->pool);
+	mlx_delete_queue(mlxctx->commands);
+	free(mlxctx->held);
+	mlx_write_trace(mlxctx);
+	mlx_lstclear((mlx_list_t**)(&mlxctx->hooks), &mlx_free_hook);
 	mlx_lstclear((mlx_list_t**)(&mlxctx->images), &mlx_free_image);
-	mlx_freen(2, mlxctx, mlx);
+	mlx_lstclear((mlx_list_t**)(&mlxctx->atlases), &free);
+	mlx_freen(4, mlxctx->render_queue, mlxctx->sort_buffer, mlxctx, mlx);
 }
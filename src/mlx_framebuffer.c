@@ -0,0 +1,147 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_framebuffer.c                                  :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:55:00 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:02:17 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+//= Private =//
+
+/**
+ * Copies a finished read to its target. OpenGL reads the rows bottom up,
+ * so they are flipped into the top down order of images.
+ */
+static void mlx_finish_read(mlx_readback_t* read)
+{
+	const size_t pitch = read->width * BPP;
+
+	mlx_wait_sync(&read->fence);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, read->buffer);
+	const uint8_t* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, pitch * read->height, GL_MAP_READ_BIT);
+	if (pixels)
+	{
+		for (int32_t y = 0; y < read->height; y++)
+			memcpy(&read->target[y * pitch], &pixels[(read->height - 1 - y) * pitch], pitch);
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	read->target = NULL;
+}
+
+//= Public =//
+
+/**
+ * Creates the framebuffer object that headless instances render into, as
+ * there's no window to present to. It stays bound for the entire run.
+ */
+bool mlx_create_offscreen(mlx_ctx_t* mlx, int32_t width, int32_t height)
+{
+	glGenFramebuffers(1, &mlx->fbo);
+	glGenRenderbuffers(1, &mlx->fbo_color);
+	glGenRenderbuffers(1, &mlx->fbo_depth);
+	mlx_resize_offscreen(mlx, width, height);
+
+	glBindFramebuffer(GL_FRAMEBUFFER, mlx->fbo);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, mlx->fbo_color);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, mlx->fbo_depth);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		return (mlx_error(MLX_WINFAIL));
+	return (true);
+}
+
+void mlx_resize_offscreen(mlx_ctx_t* mlx, int32_t width, int32_t height)
+{
+	if (!mlx->fbo || (width == mlx->fbo_width && height == mlx->fbo_height))
+		return;
+
+	mlx->fbo_width = width;
+	mlx->fbo_height = height;
+	glBindRenderbuffer(GL_RENDERBUFFER, mlx->fbo_color);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, mlx->fbo_depth);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+}
+
+/**
+ * Starts reading the frame that was just rendered if one was requested.
+ * 
+ * The read goes into a pixel buffer so it doesn't stall, the oldest buffer
+ * is reused which finishes its read first in case it is still pending.
+ * 
+ * @param mlx The MLX instance context.
+ * @param target Where the pixels go, NULL if no read was requested.
+ */
+void mlx_issue_read(mlx_ctx_t* mlx, uint8_t* target)
+{
+	if (!target)
+		return;
+	if (mlx->software)
+	{
+		mlx_read_software(mlx, target);
+		return;
+	}
+
+	mlx_readback_t* const read = &mlx->reads[mlx->read_index];
+	mlx->read_index = (mlx->read_index + 1) % MLX_READBACK_BUFFERS;
+	if (read->target)
+		mlx_finish_read(read);
+
+	GLint viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	read->width = viewport[2];
+	read->height = viewport[3];
+	read->target = target;
+	read->frames = MLX_READBACK_BUFFERS;
+
+	if (!read->buffer)
+		glGenBuffers(1, &read->buffer);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, read->buffer);
+	const size_t size = (size_t)read->width * read->height * BPP;
+	if (read->capacity < size)
+	{
+		glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+		read->capacity = size;
+	}
+	glReadPixels(0, 0, read->width, read->height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	read->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/**
+ * Copies the reads that are done to their targets, done once per frame.
+ * 
+ * Reads that are still pending after MLX_READBACK_BUFFERS frames are
+ * waited on, so the user knows when to expect the pixels.
+ * 
+ * @param mlx The MLX instance context.
+ * @param wait Whether to wait on all pending reads.
+ */
+void mlx_sync_reads(mlx_ctx_t* mlx, bool wait)
+{
+	for (uint32_t i = 0; i < MLX_READBACK_BUFFERS; i++)
+	{
+		mlx_readback_t* const read = &mlx->reads[(mlx->read_index + i) % MLX_READBACK_BUFFERS];
+
+		if (!read->target)
+			continue;
+		if (!wait && --read->frames > 0 && glClientWaitSync(read->fence, 0, 0) == GL_TIMEOUT_EXPIRED)
+			continue;
+		mlx_finish_read(read);
+	}
+}
+
+void mlx_read_framebuffer(mlx_t* mlx, uint8_t* dst)
+{
+	MLX_NONNULL(mlx);
+	MLX_NONNULL(dst);
+
+	((mlx_ctx_t*)mlx->context)->read_target = dst;
+}
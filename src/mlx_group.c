@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_group.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:42:55 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:02:17 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+//= Private =//
+
+static GLuint mlx_new_array_texture(uint32_t width, uint32_t height, uint32_t layers)
+{
+	GLuint texture;
+
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+	if (GLAD_GL_VERSION_4_2)
+		glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA8, width, height, layers);
+	else
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	return (texture);
+}
+
+static bool mlx_create_group(mlx_t* mlx, uint32_t width, uint32_t height, uint32_t count, mlx_image_t** images)
+{
+	GLint maxlayers = INT16_MAX;
+	if (!((mlx_ctx_t*)mlx->context)->software)
+		glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxlayers);
+	if (!count || count > (uint32_t)maxlayers || count > INT16_MAX)
+		return (mlx_error(MLX_INVDIM));
+
+	mlx_group_t* group;
+	if (!(group = calloc(1, sizeof(mlx_group_t))))
+		return (mlx_error(MLX_MEMFAIL));
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if ((images[i] = mlx_create_image(mlx, width, height)))
+		{
+			mlx_image_ctx_t* const imgctx = images[i]->context;
+
+			imgctx->group = group;
+			imgctx->layer = i;
+			memcpy(imgctx->uv, (uint16_t[4]){0, 0, UINT16_MAX, UINT16_MAX}, sizeof(imgctx->uv));
+			imgctx->dirty = (mlx_rect_t){0, 0, width, height};
+			group->count++;
+			continue;
+		}
+
+		// The group goes away together with its last image.
+		if (group->count == 0)
+			free(group);
+		while (i-- > 0)
+			mlx_delete_image(mlx, images[i]);
+		return (false);
+	}
+	if (!((mlx_ctx_t*)mlx->context)->software)
+		group->texture = mlx_new_array_texture(width, height, count);
+	for (uint32_t i = 0; i < count; i++)
+		((mlx_image_ctx_t*)images[i]->context)->texture = group->texture;
+	return (true);
+}
+
+//= Public =//
+
+bool mlx_new_image_group(mlx_t* mlx, uint32_t width, uint32_t height, uint32_t count, mlx_image_t** images)
+{
+	MLX_NONNULL(mlx);
+	MLX_NONNULL(images);
+
+	mlx_acquire_context(mlx->context);
+	const bool created = mlx_create_group(mlx, width, height, count, images);
+	mlx_release_context(mlx->context);
+	return (created);
+}
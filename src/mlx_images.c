@@ -6,7 +6,7 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2022/01/21 15:34:45 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/07/28 18:26:59 by sbos          ########   odam.nl         */
+/*   Updated: 2026/10/18 08:21:26 by W2Wizard      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,25 +14,71 @@
 
 //= Private =//
 
+// Points the quad attributes at a batch, it can be anywhere in the ring.
+static void mlx_point_quads(mlx_ctx_t* mlx, size_t offset)
+{
+	glBindBuffer(GL_ARRAY_BUFFER, mlx->vertices.buffer);
+	glVertexAttribIPointer(0, 2, GL_SHORT, sizeof(mlx_quad_t), (void *)(offset + offsetof(mlx_quad_t, x)));
+	glVertexAttribIPointer(1, 1, GL_INT, sizeof(mlx_quad_t), (void *)(offset + offsetof(mlx_quad_t, z)));
+	glVertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(mlx_quad_t), (void *)(offset + offsetof(mlx_quad_t, width)));
+	glVertexAttribPointer(3, 4, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(mlx_quad_t), (void *)(offset + offsetof(mlx_quad_t, uv)));
+	glVertexAttribIPointer(4, 1, GL_BYTE, sizeof(mlx_quad_t), (void *)(offset + offsetof(mlx_quad_t, tex)));
+	glVertexAttribIPointer(5, 1, GL_SHORT, sizeof(mlx_quad_t), (void *)(offset + offsetof(mlx_quad_t, layer)));
+}
+
+/**
+ * Draws the batched quads and forgets the bound textures, even if the batch
+ * is empty. Uploads rebind the active unit, so after an instanced run the
+ * bindings can't be trusted across frames.
+ */
 void mlx_flush_batch(mlx_ctx_t* mlx)
 {
 	if (mlx->batch_size <= 0)
+	{
+		memset(mlx->bound_textures, 0, sizeof(mlx->bound_textures));
 		return;
+	}
 
-	glBindBuffer(GL_ARRAY_BUFFER, mlx->vbo);
-	glBufferData(GL_ARRAY_BUFFER, mlx->batch_size * sizeof(vertex_t), mlx->batch_vertices, GL_STATIC_DRAW);
-	glDrawArrays(GL_TRIANGLES, 0, mlx->batch_size);
+	const double start = mlx_trace_begin(mlx);
+	const size_t offset = mlx_ring_push(&mlx->vertices, mlx->batch_quads, \
+		mlx->batch_size * sizeof(mlx_quad_t), sizeof(mlx_quad_t));
+	mlx_point_quads(mlx, offset);
+	glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_BYTE, NULL, mlx->batch_size);
+	mlx_trace_end(mlx, "flush", NULL, start, mlx->batch_size);
+	mlx->stats.render->draw_calls++;
+	mlx->stats.render->batches++;
+	mlx->stats.render->instances += mlx->batch_size;
 
 	mlx->batch_size = 0;
 	memset(mlx->bound_textures, 0, sizeof(mlx->bound_textures));
 }
 
+/**
+ * Texture arrays of image groups always go into the reserved unit,
+ * which is only ever flushed for another group.
+ */
+static int8_t mlx_bind_array(mlx_ctx_t* mlx, GLint handle)
+{
+	if (mlx->bound_textures[MLX_ARRAY_UNIT] == handle)
+		return (MLX_ARRAY_UNIT);
+	if (mlx->bound_textures[MLX_ARRAY_UNIT] != 0)
+		mlx_flush_batch(mlx);
+
+	mlx->bound_textures[MLX_ARRAY_UNIT] = handle;
+	glActiveTexture(GL_TEXTURE0 + MLX_ARRAY_UNIT);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, handle);
+	return (MLX_ARRAY_UNIT);
+}
+
 static int8_t mlx_bind_texture(mlx_ctx_t* mlx, mlx_image_t* img)
 {
 	const GLint handle = (GLint)((mlx_image_ctx_t*)img->context)->texture;
 
+	if (((mlx_image_ctx_t*)img->context)->group)
+		return (mlx_bind_array(mlx, handle));
+
 	// Attempt to bind the texture, or obtain the index if it is already bound.
-	for (int8_t i = 0; i < 16; i++)
+	for (int8_t i = 0; i < MLX_ARRAY_UNIT; i++)
 	{
 		if (mlx->bound_textures[i] == handle)
 			return (i);
@@ -60,48 +106,330 @@ static int8_t mlx_bind_texture(mlx_ctx_t* mlx, mlx_image_t* img)
  * Internal function to draw a single instance of an image
  * to the screen.
  */
-void mlx_draw_instance(mlx_ctx_t* mlx, mlx_image_t* img, mlx_instance_t* instance)
-{
-	float w = (float) img->width;
-	float h = (float) img->height;
-	float x = (float) instance->x;
-	float y = (float) instance->y;
-	float z = (float) instance->z;
-	int8_t tex = mlx_bind_texture(mlx, img);
-
-	vertex_t vertices[6] = {
-			(vertex_t){x, y, z, 0.f, 0.f, tex},
-			(vertex_t){x + w, y + h, z, 1.f, 1.f, tex},
-			(vertex_t){x + w, y, z, 1.f, 0.f, tex},
-			(vertex_t){x, y, z, 0.f, 0.f, tex},
-			(vertex_t){x, y + h, z, 0.f, 1.f, tex},
-			(vertex_t){x + w, y + h, z, 1.f, 1.f, tex},
+void mlx_draw_instance(mlx_ctx_t* mlx, mlx_image_t* img, const mlx_instance_t* instance)
+{
+	const mlx_image_ctx_t* imgctx = img->context;
+
+	// Quads entirely off screen are skipped, which keeps positions within 16 bits.
+	if (instance->x >= mlx->viewWidth || instance->y >= mlx->viewHeight || \
+		instance->x > INT16_MAX || instance->y > INT16_MAX || \
+		instance->x + (int32_t)img->width <= 0 || instance->y + (int32_t)img->height <= 0)
+		return;
+
+	const int8_t tex = mlx_bind_texture(mlx, img);
+	mlx->batch_quads[mlx->batch_size++] = (mlx_quad_t){
+		instance->x, instance->y, img->width, img->height, instance->z,
+		{imgctx->uv[0], imgctx->uv[1], imgctx->uv[2], imgctx->uv[3]},
+		tex, imgctx->layer
 	};
-	memmove(mlx->batch_vertices + mlx->batch_size, vertices, sizeof(vertices));
-	mlx->batch_size += 6;
 
 	if (mlx->batch_size >= MLX_BATCH_SIZE)
 		mlx_flush_batch(mlx);
 }
 
-mlx_instance_t* mlx_grow_instances(mlx_image_t* img, bool* did_realloc)
+/**
+ * Internal function to draw a run of instances of an image with a
+ * single instanced draw call.
+ * 
+ * The instances are uploaded as they are, the shader builds the quad of
+ * each one from the image size. Disabled instances are discarded there.
+ * 
+ * @param mlx The MLX instance context.
+ * @param img The image to draw.
+ * @param instances The first instance of the run.
+ * @param count The amount of instances in the run.
+ */
+void mlx_draw_instances(mlx_ctx_t* mlx, mlx_image_t* img, const mlx_instance_t* instances, int32_t count)
+{
+	// The batch has to go first to keep the draw order intact.
+	mlx_flush_batch(mlx);
+	const double start = mlx_trace_begin(mlx);
+	const int8_t tex = mlx_bind_texture(mlx, img);
+
+	// Without arrays enabled the attributes are constant for every instance.
+	const mlx_image_ctx_t* imgctx = img->context;
+	glBindVertexArray(mlx->instance_vao);
+	glVertexAttrib2f(2, img->width, img->height);
+	glVertexAttrib4Nusv(3, imgctx->uv);
+	glVertexAttribI1i(4, tex);
+	glVertexAttribI1i(5, imgctx->layer);
+
+	// Long runs are split up into pieces that fit into a section of the ring.
+	const int32_t max = mlx->vertices.size / MLX_RING_SECTIONS / sizeof(mlx_instance_t);
+	for (int32_t i = 0; i < count; i += max)
+	{
+		const int32_t amount = count - i < max ? count - i : max;
+		const size_t offset = mlx_ring_push(&mlx->vertices, instances + i, \
+			amount * sizeof(mlx_instance_t), sizeof(mlx_instance_t));
+
+		glBindBuffer(GL_ARRAY_BUFFER, mlx->vertices.buffer);
+		glVertexAttribIPointer(0, 2, GL_INT, sizeof(mlx_instance_t), \
+			(void *)(offset + offsetof(mlx_instance_t, x)));
+		glVertexAttribIPointer(1, 1, GL_INT, sizeof(mlx_instance_t), \
+			(void *)(offset + offsetof(mlx_instance_t, z)));
+		glVertexAttribIPointer(6, 1, GL_UNSIGNED_BYTE, sizeof(mlx_instance_t), \
+			(void *)(offset + offsetof(mlx_instance_t, enabled)));
+		glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_BYTE, NULL, amount);
+		mlx->stats.render->draw_calls++;
+	}
+	mlx->stats.render->instances += count;
+	glBindVertexArray(mlx->vao);
+	mlx_trace_end(mlx, "instances", img, start, count);
+}
+
+/**
+ * Resets the dirty rect of an image to an empty region, which is
+ * done after its pixels have been uploaded.
+ */
+void mlx_clear_dirty(mlx_image_t* img)
 {
 	mlx_image_ctx_t* const ctx = img->context;
-	if (img->count >= ctx->instances_capacity)
+
+	ctx->dirty = (mlx_rect_t){UINT32_MAX, UINT32_MAX, 0, 0};
+}
+
+/**
+ * Creates a texture and allocates its storage.
+ * 
+ * The storage is allocated once, uploads only ever update its contents.
+ * Where available the storage is immutable, meaning it has to be re-created
+ * when the image is resized, which is exactly what we want anyway.
+ */
+GLuint mlx_new_texture(uint32_t width, uint32_t height)
+{
+	GLuint texture;
+
+	if (mlx_settings[MLX_SOFTWARE])
+		return (0);
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+	if (GLAD_GL_VERSION_4_2)
+		glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+	else
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	return (texture);
+}
+
+/**
+ * Gives an image a texture of its own, covering all of it.
+ */
+void mlx_create_texture(mlx_image_t* img)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+
+	imgctx->texture = mlx_new_texture(img->width, img->height);
+	imgctx->group = NULL;
+	imgctx->layer = 0;
+	imgctx->atlas = NULL;
+	imgctx->atlas_x = 0;
+	imgctx->atlas_y = 0;
+	memcpy(imgctx->uv, (uint16_t[4]){0, 0, UINT16_MAX, UINT16_MAX}, sizeof(imgctx->uv));
+
+	// The storage is uninitialized, so everything has to be uploaded.
+	imgctx->dirty = (mlx_rect_t){0, 0, img->width, img->height};
+}
+
+/**
+ * Lets go of the texture of an image, shared textures are only
+ * deleted once no image uses them anymore.
+ */
+void mlx_release_texture(mlx_image_t* img)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+
+	if (imgctx->atlas)
+		mlx_atlas_release(img);
+	else if (imgctx->group && --imgctx->group->count > 0)
+		imgctx->group = NULL;
+	else
 	{
-		if (ctx->instances_capacity == 0)
-			ctx->instances_capacity = img->count;
-		else
-			ctx->instances_capacity *= 2;
-		*did_realloc = true;
-		return realloc(img->instances, ctx->instances_capacity * sizeof(mlx_instance_t));
+		if (imgctx->texture)
+			glDeleteTextures(1, &imgctx->texture);
+		free(imgctx->group);
+		imgctx->group = NULL;
 	}
-	*did_realloc = false;
-	return img->instances;
+	imgctx->texture = 0;
+}
+
+/**
+ * Moves an image with a shared texture into a texture of its own, needed
+ * for anything that works on the whole texture such as streaming.
+ */
+void mlx_unshare_texture(mlx_image_t* img)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+
+	if (!imgctx->atlas && !imgctx->group)
+		return;
+	mlx_release_texture(img);
+	mlx_create_texture(img);
+}
+
+/**
+ * Uploads a region of an image to its texture.
+ * 
+ * @returns The amount of bytes that were uploaded.
+ */
+size_t mlx_upload_rect(mlx_image_t* img, mlx_rect_t rect)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+
+	// The render thread owns the context, it uploads a copy later on.
+	if (imgctx->mlx->pipeline)
+		return (mlx_stage_rect(img, rect));
+
+	const uint8_t* front = mlx_front_pixels(img);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, img->width);
+	if (imgctx->group)
+	{
+		const uint8_t* pixels = &front[(rect.y0 * img->width + rect.x0) * BPP];
+		glBindTexture(GL_TEXTURE_2D_ARRAY, imgctx->texture);
+		glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, rect.x0, rect.y0, imgctx->layer, rect.x1 - rect.x0, rect.y1 - rect.y0, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+	}
+	else if (imgctx->stream)
+	{
+		glBindTexture(GL_TEXTURE_2D, imgctx->texture);
+		mlx_stream_image(img, rect);
+	}
+	else
+	{
+		const uint8_t* pixels = &front[(rect.y0 * img->width + rect.x0) * BPP];
+		const uint32_t x = imgctx->atlas_x + rect.x0;
+		const uint32_t y = imgctx->atlas_y + rect.y0;
+		glBindTexture(GL_TEXTURE_2D, imgctx->texture);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, rect.x1 - rect.x0, rect.y1 - rect.y0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+	}
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	return ((size_t)(rect.x1 - rect.x0) * (rect.y1 - rect.y0) * BPP);
+}
+
+/**
+ * Uploads the modified region of an image to its texture.
+ * 
+ * Without dirty tracking we can't know what the user did to the pixels
+ * so the whole image is re-uploaded every frame.
+ * 
+ * @returns The amount of bytes that were uploaded.
+ */
+size_t mlx_upload_image(mlx_image_t* img)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+
+	mlx_acquire_front(img);
+	if (mlx_progress_pending(img))
+		return (mlx_upload_progress(img));
+	if (!mlx_settings[MLX_DIRTY_TRACKING])
+		mlx_image_mark_dirty(img, 0, 0, img->width, img->height);
+
+	const mlx_rect_t dirty = imgctx->dirty;
+	if (dirty.x0 >= dirty.x1 || dirty.y0 >= dirty.y1)
+		return (0);
+	mlx_clear_dirty(img);
+	return (mlx_upload_rect(img, dirty));
+}
+
+static bool mlx_grow_instances(mlx_image_t* img)
+{
+	mlx_image_ctx_t* const ctx = img->context;
+	if (img->count < ctx->instances_capacity)
+		return (true);
+
+	const size_t capacity = ctx->instances_capacity ? ctx->instances_capacity * 2 : 1;
+	mlx_instance_t* instances;
+	if (!(instances = realloc(img->instances, capacity * sizeof(mlx_instance_t))))
+		return (false);
+	img->instances = instances;
+	ctx->instances_capacity = capacity;
+	return (true);
+}
+
+static bool mlx_grow_renderqueue(mlx_ctx_t* mlx)
+{
+	if (mlx->render_count < mlx->render_capacity)
+		return (true);
+
+	const size_t capacity = mlx->render_capacity ? mlx->render_capacity * 2 : 64;
+	draw_queue_t* queue;
+	if (!(queue = realloc(mlx->render_queue, capacity * sizeof(draw_queue_t))))
+		return (false);
+	mlx->render_queue = queue;
+	mlx->render_capacity = capacity;
+	return (true);
+}
+
+/**
+ * Reallocates the pixels and texture of an image for its new size.
+ */
+static bool mlx_resize_storage(mlx_image_t* img, uint32_t nwidth, uint32_t nheight)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+	mlx_stream_t* const stream = imgctx->stream;
+	mlx_atlas_t* const atlas = imgctx->atlas;
+
+	// Tiles rendered in the background would be out of bounds.
+	mlx_delete_progress(img);
+
+	// Mapped pixels belong to the driver, they can't be reallocated.
+	if (stream && stream->mapping)
+		return (mlx_resize_mapping(img, nwidth, nheight));
+
+	if (imgctx->buffers)
+	{
+		if (!mlx_resize_buffers(img, (nwidth * nheight) * BPP))
+			return (false);
+	}
+	else
+	{
+		uint8_t* tempbuff = realloc(img->pixels, (nwidth * nheight) * BPP);
+		if (!tempbuff)
+			return (mlx_error(MLX_MEMFAIL));
+		img->pixels = tempbuff;
+	}
+	(*(uint32_t*)&img->width) = nwidth;
+	(*(uint32_t*)&img->height) = nheight;
+
+	// Storage is only ever allocated here or on creation.
+	if (atlas)
+	{
+		mlx_atlas_release(img);
+		if (!mlx_atlas_place(atlas->mlx, img))
+			mlx_create_texture(img);
+		return (true);
+	}
+	mlx_release_texture(img);
+	mlx_create_texture(img);
+	if (stream)
+	{
+		mlx_delete_stream(img);
+		return (mlx_create_stream(img));
+	}
+	return (true);
 }
 
 //= Public =//
 
+void mlx_image_mark_dirty(mlx_image_t* image, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+	MLX_NONNULL(image);
+
+	if (x >= image->width || y >= image->height)
+		return;
+
+	mlx_rect_t* const dirty = &((mlx_image_ctx_t*)image->context)->dirty;
+	const uint32_t x1 = width > image->width - x ? image->width : x + width;
+	const uint32_t y1 = height > image->height - y ? image->height : y + height;
+
+	dirty->x0 = x < dirty->x0 ? x : dirty->x0;
+	dirty->y0 = y < dirty->y0 ? y : dirty->y0;
+	dirty->x1 = x1 > dirty->x1 ? x1 : dirty->x1;
+	dirty->y1 = y1 > dirty->y1 ? y1 : dirty->y1;
+}
+
 void mlx_set_instance_depth(mlx_instance_t* instance, int32_t zdepth)
 {
 	MLX_NONNULL(instance);
@@ -124,44 +452,32 @@ int32_t mlx_image_to_window(mlx_t* mlx, mlx_image_t* img, int32_t x, int32_t y)
 	MLX_NONNULL(img);
 
 	// Allocate buffers...
-	img->count++;
-	bool did_realloc;
-	mlx_instance_t* instances = mlx_grow_instances(img, &did_realloc);
-	draw_queue_t* queue = calloc(1, sizeof(draw_queue_t));
-	if (!instances || !queue)
-	{
-		if (did_realloc)
-			free(instances);
-		return (free(queue), mlx_error(MLX_MEMFAIL), -1);
-	}
+	mlx_ctx_t* const mlxctx = mlx->context;
+	if (!mlx_grow_instances(img) || !mlx_grow_renderqueue(mlxctx))
+		return (mlx_error(MLX_MEMFAIL), -1);
 
 	// Set data...
-	queue->image = img;
-	int32_t index = queue->instanceid = img->count - 1;
-	img->instances = instances;
+	const int32_t index = img->count++;
 	img->instances[index].x = x;
 	img->instances[index].y = y;
 
 	// NOTE: We keep updating the Z for the convenience of the user.
 	// Always update Z depth to prevent overlapping images by default.
-	img->instances[index].z = ((mlx_ctx_t*)mlx->context)->zdepth++;
+	img->instances[index].z = mlxctx->zdepth++;
 	img->instances[index].enabled = true;
 
 	// Add draw call...
 	sort_queue = true;
-	mlx_list_t* templst;
-	if ((templst = mlx_lstnew(queue)))
-	{
-		mlx_lstadd_front(&((mlx_ctx_t*)mlx->context)->render_queue, templst);
-		return (index);
-	}
-	return (mlx_freen(2, instances, queue), mlx_error(MLX_MEMFAIL), -1);
+	mlxctx->render_queue[mlxctx->render_count++] = (draw_queue_t){img, index, img->instances[index].z};
+	return (index);
 }
 
-mlx_image_t* mlx_new_image(mlx_t* mlx, uint32_t width, uint32_t height)
+/**
+ * Allocates a new image and adds it to the image list, it's up to the
+ * caller to give it a texture.
+ */
+mlx_image_t* mlx_create_image(mlx_t* mlx, uint32_t width, uint32_t height)
 {
-	MLX_NONNULL(mlx);
-
 	if (!width || !height || width > INT16_MAX || height > INT16_MAX)
 		return ((void*)mlx_error(MLX_INVDIM));
 
@@ -175,6 +491,7 @@ mlx_image_t* mlx_new_image(mlx_t* mlx, uint32_t width, uint32_t height)
 	}
 	newimg->enabled = true;
 	newimg->context = newctx;
+	newctx->mlx = mlx->context;
 	(*(uint32_t*)&newimg->width) = width;
 	(*(uint32_t*)&newimg->height) = height;
 	if (!(newimg->pixels = calloc(width * height, sizeof(int32_t))))
@@ -190,17 +507,24 @@ mlx_image_t* mlx_new_image(mlx_t* mlx, uint32_t width, uint32_t height)
 		return ((void *)mlx_error(MLX_MEMFAIL));
 	}
 
-	// Generate OpenGL texture
-	glGenTextures(1, &newctx->texture);
-	glBindTexture(GL_TEXTURE_2D, newctx->texture);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 	mlx_lstadd_front((mlx_list_t**)(&mlxctx->images), newentry);
 	return (newimg);
 }
 
+mlx_image_t* mlx_new_image(mlx_t* mlx, uint32_t width, uint32_t height)
+{
+	MLX_NONNULL(mlx);
+
+	mlx_image_t* newimg;
+	if (!(newimg = mlx_create_image(mlx, width, height)))
+		return (NULL);
+	mlx_acquire_context(mlx->context);
+	if (!((mlx_ctx_t*)mlx->context)->software && !mlx_atlas_place(mlx->context, newimg))
+		mlx_create_texture(newimg);
+	mlx_release_context(mlx->context);
+	return (newimg);
+}
+
 void mlx_delete_image(mlx_t* mlx, mlx_image_t* image)
 {
 	MLX_NONNULL(mlx);
@@ -208,15 +532,25 @@ void mlx_delete_image(mlx_t* mlx, mlx_image_t* image)
 
 	mlx_ctx_t* mlxctx = mlx->context;
 
-	// Delete all instances in the render queue
-	mlx_list_t* quelst;
-	while ((quelst = mlx_lstremove(&mlxctx->render_queue, image, &mlx_equal_inst)))
-		mlx_freen(2, quelst->content, quelst);
+	// Delete all instances in the render queue, keeping the rest in order
+	size_t count = 0;
+	for (size_t i = 0; i < mlxctx->render_count; i++)
+	{
+		if (mlxctx->render_queue[i].image != image)
+			mlxctx->render_queue[count++] = mlxctx->render_queue[i];
+	}
+	mlxctx->render_count = count;
 
 	mlx_list_t* imglst;
 	if ((imglst = mlx_lstremove(&mlxctx->images, image, &mlx_equal_image)))
 	{
-		glDeleteTextures(1, &((mlx_image_ctx_t*)image->context)->texture);
+		mlx_delete_progress(image);
+		mlx_drop_commands(mlxctx, image);
+		mlx_acquire_context(mlxctx);
+		mlx_delete_buffers(image);
+		mlx_delete_stream(image);
+		mlx_release_texture(image);
+		mlx_release_context(mlxctx);
 		mlx_freen(5, image->pixels, image->instances, image->context, imglst, image);
 	}
 }
@@ -227,15 +561,12 @@ bool mlx_resize_image(mlx_image_t* img, uint32_t nwidth, uint32_t nheight)
 
 	if (!nwidth || !nheight || nwidth > INT16_MAX || nheight > INT16_MAX)
 		return (mlx_error(MLX_INVDIM));
-	if (nwidth != img->width || nheight != img->height)
-	{
-		uint8_t* tempbuff = realloc(img->pixels, (nwidth * nheight) * BPP);
-		if (!tempbuff)
-			return (mlx_error(MLX_MEMFAIL));
-		img->pixels = tempbuff;
-		(*(uint32_t*)&img->width) = nwidth;
-		(*(uint32_t*)&img->height) = nheight;
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, nwidth, nheight, 0, GL_RGBA, GL_UNSIGNED_BYTE, img->pixels);
-	}
-	return (true);
+	if (nwidth == img->width && nheight == img->height)
+		return (true);
+
+	mlx_ctx_t* const mlxctx = ((mlx_image_ctx_t*)img->context)->mlx;
+	mlx_acquire_context(mlxctx);
+	const bool resized = mlx_resize_storage(img, nwidth, nheight);
+	mlx_release_context(mlxctx);
+	return (resized);
 }
@@ -6,7 +6,7 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2021/12/28 00:24:30 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/08/10 13:00:53 by lde-la-h      ########   odam.nl         */
+/*   Updated: 2026/10/18 08:02:17 by W2Wizard      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,32 +16,109 @@
 
 static void framebuffer_callback(GLFWwindow *window, int width, int height)
 {
-	(void)window;
+	const mlx_t* mlx = glfwGetWindowUserPointer(window);
+
+	mlx_acquire_context(mlx->context);
+	mlx_resize_offscreen(mlx->context, width, height);
 	glViewport(0, 0, width, height);
+	mlx_release_context(mlx->context);
+}
+
+/**
+ * Offscreen instances don't need a display at all if GLFW can do without,
+ * its null platform creates the context through EGL or OSMesa instead.
+ */
+static bool mlx_init_glfw(bool offscreen)
+{
+#ifdef GLFW_PLATFORM_NULL
+	if (offscreen && glfwPlatformSupported(GLFW_PLATFORM_NULL))
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+	const bool init = glfwInit();
+	glfwInitHint(GLFW_PLATFORM, GLFW_ANY_PLATFORM);
+	return (init);
+#else
+	(void)offscreen;
+	return (glfwInit());
+#endif
+}
+
+static void mlx_window_hints(bool resize)
+{
+	const bool offscreen = mlx_settings[MLX_HEADLESS] || mlx_settings[MLX_SOFTWARE];
+
+	glfwWindowHint(GLFW_CLIENT_API, mlx_settings[MLX_SOFTWARE] ? GLFW_NO_API : GLFW_OPENGL_API);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_MAXIMIZED, mlx_settings[MLX_MAXIMIZED]);
+	glfwWindowHint(GLFW_DECORATED, mlx_settings[MLX_DECORATED]);
+	glfwWindowHint(GLFW_VISIBLE, !offscreen);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+	glfwWindowHint(GLFW_RESIZABLE, resize);
+}
+
+static GLFWwindow* mlx_create_window(int32_t width, int32_t height, const char* title, bool resize)
+{
+	mlx_window_hints(resize);
+	GLFWmonitor* monitor = mlx_settings[MLX_FULLSCREEN] ? glfwGetPrimaryMonitor() : NULL;
+	GLFWwindow* window = glfwCreateWindow(width, height, title, monitor, NULL);
+
+#ifdef GLFW_PLATFORM_NULL
+	// Without a context backend for the null platform we still need a display.
+	if (!window && glfwGetPlatform() == GLFW_PLATFORM_NULL)
+	{
+		glfwTerminate();
+		if (mlx_init_glfw(false))
+		{
+			mlx_window_hints(resize);
+			window = glfwCreateWindow(width, height, title, NULL, NULL);
+		}
+	}
+#endif
+	return (window);
+}
+
+static void mlx_enable_instanced(GLuint index)
+{
+	glVertexAttribDivisor(index, 1);
+	glEnableVertexAttribArray(index);
 }
 
 static bool mlx_create_buffers(mlx_t* mlx)
 {
 	mlx_ctx_t* mlxctx = mlx->context;
 
+	// The two triangles of a quad, made of its four corners in the shader.
+	const uint8_t indices[6] = {0, 1, 2, 0, 3, 1};
+
 	mlxctx->zdepth = 0;
 	glActiveTexture(GL_TEXTURE0);
+	mlx_create_ring(&mlxctx->vertices, MLX_RING_SIZE);
 	glGenVertexArrays(1, &(mlxctx->vao));
-	glGenBuffers(1, &(mlxctx->vbo));
+	glGenBuffers(1, &(mlxctx->ebo));
 	glBindVertexArray(mlxctx->vao);
-	glBindBuffer(GL_ARRAY_BUFFER, mlxctx->vbo);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mlxctx->ebo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
 
-	// Vertex XYZ coordinates
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(vertex_t), NULL);
-	glEnableVertexAttribArray(0);
+	// Every quad is an instance of the same four corners, the attributes
+	// are pointed at the quads each time they are drawn.
+	for (GLuint i = 0; i <= 5; i++)
+		mlx_enable_instanced(i);
 
-	// UV Coordinates
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(vertex_t), (void *)(sizeof(float) * 3));
-	glEnableVertexAttribArray(1);
+	// Instanced images read the instances as they are: XY, depth and enabled.
+	// The rest is the same for every instance and set as constant values.
+	glGenVertexArrays(1, &(mlxctx->instance_vao));
+	glBindVertexArray(mlxctx->instance_vao);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mlxctx->ebo);
+	mlx_enable_instanced(0);
+	mlx_enable_instanced(1);
+	mlx_enable_instanced(6);
+	glBindVertexArray(mlxctx->vao);
 
-	// Texture index
-	glVertexAttribIPointer(2, 1, GL_BYTE, sizeof(vertex_t), (void *)(sizeof(float) * 5));
-	glEnableVertexAttribArray(2);
+	// Quads are always enabled, hidden ones are never batched.
+	glVertexAttribI1i(6, 1);
 
 	glEnable(GL_BLEND);
 	glEnable(GL_DEPTH_TEST);
@@ -62,7 +139,7 @@ static bool mlx_create_buffers(mlx_t* mlx)
 	glUniform1i(glGetUniformLocation(mlxctx->shaderprogram, "Texture12"), 12);
 	glUniform1i(glGetUniformLocation(mlxctx->shaderprogram, "Texture13"), 13);
 	glUniform1i(glGetUniformLocation(mlxctx->shaderprogram, "Texture14"), 14);
-	glUniform1i(glGetUniformLocation(mlxctx->shaderprogram, "Texture15"), 15);
+	glUniform1i(glGetUniformLocation(mlxctx->shaderprogram, "TextureArray"), MLX_ARRAY_UNIT);
 
 	return (true);
 }
@@ -146,7 +223,7 @@ static bool mlx_init_render(mlx_t* mlx)
 // NOTE: https://www.glfw.org/docs/3.3/group__window.html
 
 // Default settings
-int32_t mlx_settings[MLX_SETTINGS_MAX] = {false, false, false, true, false};
+int32_t mlx_settings[MLX_SETTINGS_MAX] = {false, false, false, true, false, false, false, false, 0, false};
 mlx_errno_t mlx_errno = MLX_SUCCESS;
 bool sort_queue = false;
 
@@ -158,7 +235,8 @@ mlx_t* mlx_init(int32_t width, int32_t height, const char* title, bool resize)
 
 	bool init;
 	mlx_t* mlx;
-	if (!(init = glfwInit()))
+	mlx_init_kernels();
+	if (!(init = mlx_init_glfw(mlx_settings[MLX_HEADLESS] || mlx_settings[MLX_SOFTWARE])))
 		return ((void*)mlx_error(MLX_GLFWFAIL));
 	if (!(mlx = calloc(1, sizeof(mlx_t))))
 		return ((void*)mlx_error(MLX_MEMFAIL));
@@ -170,21 +248,30 @@ mlx_t* mlx_init(int32_t width, int32_t height, const char* title, bool resize)
 	mlx->height = height;
 	mlxctx->initialWidth = width;
 	mlxctx->initialHeight = height;
+	mlxctx->viewWidth = width;
+	mlxctx->viewHeight = height;
+	mlxctx->stats.render = &mlxctx->stats.current;
 
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-	glfwWindowHint(GLFW_MAXIMIZED, mlx_settings[MLX_MAXIMIZED]);
-	glfwWindowHint(GLFW_DECORATED, mlx_settings[MLX_DECORATED]);
-	glfwWindowHint(GLFW_VISIBLE, !mlx_settings[MLX_HEADLESS]);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#ifdef __APPLE__
-	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#endif
-	glfwWindowHint(GLFW_RESIZABLE, resize);
-	if (!(mlx->window = glfwCreateWindow(width, height, title, mlx_settings[MLX_FULLSCREEN] ? glfwGetPrimaryMonitor() : NULL, NULL)))
+	if (!(mlx->window = mlx_create_window(width, height, title, resize)))
 		return (mlx_terminate(mlx), (void*)mlx_error(MLX_WINFAIL));
+
+	// The software backend has no context, it only needs the window for input.
+	if (mlx_settings[MLX_SOFTWARE])
+	{
+		glfwSetWindowUserPointer(mlx->window, mlx);
+		if (!mlx_create_software(mlxctx, width, height))
+			return (mlx_terminate(mlx), NULL);
+		return (mlx);
+	}
 	if (!mlx_init_render(mlx) || !mlx_create_buffers(mlx))
 		return (mlx_terminate(mlx), NULL);
+
+	int32_t fbwidth, fbheight;
+	glfwGetFramebufferSize(mlx->window, &fbwidth, &fbheight);
+	if (mlx_settings[MLX_HEADLESS] && !mlx_create_offscreen(mlxctx, fbwidth, fbheight))
+		return (mlx_terminate(mlx), NULL);
+	if (mlx_settings[MLX_PIPELINED] && !mlx_create_pipeline(mlx))
+		return (mlx_terminate(mlx), NULL);
 	return (mlx);
 }
 
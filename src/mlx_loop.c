@@ -6,7 +6,7 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2021/12/28 01:24:36 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/06/27 18:07:04 by lde-la-h      ########   odam.nl         */
+/*   Updated: 2026/10/18 08:27:07 by W2Wizard      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,67 +16,166 @@
 
 static void mlx_exec_loop_hooks(mlx_t* mlx)
 {
-	const mlx_ctx_t* mlxctx = mlx->context;
+	mlx_ctx_t* mlxctx = mlx->context;
 
 	mlx_list_t* lstcpy = mlxctx->hooks;
 	while (lstcpy && !glfwWindowShouldClose(mlx->window))
 	{
 		mlx_hook_t* hook = ((mlx_hook_t*)lstcpy->content);
+		const double start = mlx_trace_begin(mlxctx);
 		hook->func(hook->param);
+		mlx_trace_end(mlxctx, hook->name, (void*)(uintptr_t)hook->func, start, 0);
 		lstcpy = lstcpy->next;
 	}
 }
 
+/**
+ * Returns the length of the run of draw calls starting at the given one,
+ * that draws consecutive instances of the same image.
+ */
+static size_t mlx_instance_run(const draw_queue_t* queue, size_t count, size_t start)
+{
+	const draw_queue_t* drawcall = &queue[start];
+
+	size_t run = 1;
+	while (start + run < count &&
+		drawcall[run].image == drawcall->image &&
+		drawcall[run].instanceid == drawcall->instanceid + (int32_t)run)
+		run++;
+	return (run);
+}
+
+/**
+ * Executes the draw calls of a sorted render queue, long runs of the same
+ * image are drawn instanced.
+ * 
+ * @param mlx The MLX instance context.
+ * @param queue The render queue.
+ * @param snapshot Copies of the instances in queue order, or NULL to draw
+ * the instances of the images themselves.
+ * @param count The amount of draw calls in the queue.
+ */
+void mlx_draw_queue(mlx_ctx_t* mlx, const draw_queue_t* queue, const mlx_instance_t* snapshot, size_t count)
+{
+	size_t run;
+	for (size_t i = 0; i < count; i += run)
+	{
+		const draw_queue_t* drawcall = &queue[i];
+		mlx_image_t* image = drawcall->image;
+
+		// Within a run the instances of the image are consecutive as well.
+		run = mlx_instance_run(queue, count, i);
+		const mlx_instance_t* instances = snapshot ? &snapshot[i] : &image->instances[drawcall->instanceid];
+		if (!snapshot && !image->enabled)
+			continue;
+		if (run >= MLX_INSTANCED_MIN)
+		{
+			mlx_draw_instances(mlx, image, instances, run);
+			continue;
+		}
+		for (size_t j = 0; j < run; j++)
+		{
+			if (instances[j].enabled)
+				mlx_draw_instance(mlx, image, &instances[j]);
+		}
+	}
+}
+
+static void mlx_sort_images(mlx_ctx_t* mlxctx)
+{
+	if (sort_queue)
+	{
+		const double start = mlx_trace_begin(mlxctx);
+		sort_queue = false;
+		mlx_sort_renderqueue(mlxctx);
+		mlx_trace_end(mlxctx, "sort", mlxctx->render_queue, start, mlxctx->render_count);
+	}
+	mlx_stats_phase(mlxctx, &mlxctx->stats.current.sort_time);
+}
+
 static void mlx_render_images(mlx_t* mlx)
 {
 	mlx_ctx_t* mlxctx = mlx->context;
 	mlx_list_t* imglst = mlxctx->images;
+	mlx_frame_stats_t* stats = &mlxctx->stats.current;
 
-	if (sort_queue)
+	// The software backend reads the pixels of the images directly.
+	if (mlxctx->software)
 	{
-		sort_queue = false;
-		mlx_sort_renderqueue(&mlxctx->render_queue);
+		const double start = mlx_trace_begin(mlxctx);
+		mlx_render_software(mlxctx, mlx->width, mlx->height);
+		mlx_trace_end(mlxctx, "composite", mlxctx->software, start, mlxctx->render_count);
+		mlx_stats_phase(mlxctx, &stats->draw_time);
+		return;
 	}
 
-	// Upload image textures to GPU
+	// Reclaim the atlas space of images that were deleted or resized
+	mlx_repack_atlases(mlxctx);
+
+	// Upload the modified image textures to GPU
 	while (imglst)
 	{
 		mlx_image_t* image;
 		if (!(image = imglst->content))
 			return ((void)mlx_error(MLX_INVIMG));
-		glBindTexture(GL_TEXTURE_2D, ((mlx_image_ctx_t*)image->context)->texture);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image->width, image->height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image->pixels);
+		const double start = mlx_trace_begin(mlxctx);
+		const size_t bytes = mlx_upload_image(image);
+		if (bytes > 0)
+			mlx_trace_end(mlxctx, "upload", image, start, bytes);
+		stats->upload_bytes += bytes;
 		imglst = imglst->next;
 	}
+	mlx_stats_phase(mlxctx, &stats->upload_time);
 
-	// Execute draw calls
-	mlx_list_t* render_queue = mlxctx->render_queue;
-	while (render_queue)
-	{
-		draw_queue_t* drawcall = render_queue->content;
-		mlx_instance_t* instance =  &drawcall->image->instances[drawcall->instanceid];
+	mlx_draw_queue(mlxctx, mlxctx->render_queue, NULL, mlxctx->render_count);
+	mlx_flush_batch(mlxctx);
+	mlx_stats_phase(mlxctx, &stats->draw_time);
+}
 
-		if (drawcall && drawcall->image->enabled && instance->enabled)
-			mlx_draw_instance(mlx->context, drawcall->image, instance);
-		render_queue = render_queue->next;
-	}
+/**
+ * Renders and presents the frame on the main thread, with a pipelined
+ * loop the render thread does this instead, see mlx_pipeline.c.
+ */
+static void mlx_render_frame(mlx_t* mlx)
+{
+	mlx_ctx_t* mlxctx = mlx->context;
+
+	mlx_render_images(mlx);
+	mlx_issue_read(mlxctx, mlxctx->read_target);
+	mlxctx->read_target = NULL;
+
+	// Offscreen frames have nothing to present, only the commands to submit.
+	const double swap = mlx_trace_begin(mlxctx);
+	if (mlxctx->fbo)
+		glFlush();
+	else if (!mlxctx->software)
+		glfwSwapBuffers(mlx->window);
+	mlx_trace_end(mlxctx, "swap", mlx->window, swap, 0);
+	mlx_stats_phase(mlxctx, &mlxctx->stats.current.swap_time);
+	mlx_sync_streams(mlxctx);
+	mlx_sync_reads(mlxctx, false);
 }
 
 //= Public =//
 
 bool mlx_loop_hook(mlx_t* mlx, void (*f)(void*), void* param)
+{
+	return (mlx_named_loop_hook(mlx, f, param, NULL));
+}
+
+bool mlx_named_loop_hook(mlx_t* mlx, void (*f)(void*), void* param, const char* name)
 {
 	MLX_ASSERT(mlx, "Parameter can't be null");
 	MLX_ASSERT(f, "Parameter can't be null");
 
 	mlx_hook_t* hook;
-	if (!(hook = malloc(sizeof(mlx_hook_t))))
+	if (!(hook = calloc(1, sizeof(mlx_hook_t))))
 		return (mlx_error(MLX_MEMFAIL));
 
 	mlx_list_t* lst;
-	if (!(lst = mlx_lstnew(hook)))
+	if ((name && !(hook->name = strdup(name))) || !(lst = mlx_lstnew(hook)))
 	{
-		free(hook);
+		mlx_freen(2, hook->name, hook);
 		return (mlx_error(MLX_MEMFAIL));
 	}
 	hook->func = f;
@@ -91,25 +190,39 @@ void mlx_loop(mlx_t* mlx)
 {
 	MLX_ASSERT(mlx, "Parameter can't be null");
 
+	mlx_ctx_t* mlxctx = mlx->context;
+	const bool gl = !mlxctx->software && !mlxctx->pipeline;
 	double start, oldstart = 0;
 	while (!glfwWindowShouldClose(mlx->window))
 	{
 		start = glfwGetTime();
 		mlx->delta_time = start - oldstart;
 		oldstart = start;
+		mlx_stats_begin(mlxctx);
 	
-		glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		if (gl)
+		{
+			glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		}
 		glfwGetWindowSize(mlx->window, &(mlx->width), &(mlx->height));
 
-		if ((mlx->width > 1 || mlx->height > 1))
-			mlx_update_matrix(mlx, mlx->width, mlx->height);
+		if (gl && (mlx->width > 1 || mlx->height > 1))
+			mlx_update_matrix(mlx, mlx->width, mlx->height, mlxctx->zdepth);
+		mlx_apply_commands(mlx);
+		mlx_reap_progress(mlxctx);
 
+		mlx_stats_phase(mlxctx, NULL);
 		mlx_exec_loop_hooks(mlx);
-		mlx_render_images(mlx);
-		mlx_flush_batch(mlx->context);
-
-		glfwSwapBuffers(mlx->window);
+		mlx_stats_phase(mlxctx, &mlxctx->stats.current.hooks_time);
+		mlx_sort_images(mlxctx);
+
+		// Events are polled while the render thread draws the frame.
+		if (mlxctx->pipeline)
+			mlx_submit_frame(mlx);
+		else
+			mlx_render_frame(mlx);
+		mlx_stats_end(mlxctx);
 		glfwPollEvents();
 	}
 }
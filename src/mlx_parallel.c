@@ -0,0 +1,270 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_parallel.c                                     :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:14:58 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:27:07 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+//= Private =//
+
+// The tiles of an image, numbered row by row.
+typedef struct mlx_tiles
+{
+	mlx_image_t*	image;
+	uint32_t		width;
+	uint32_t		height;
+	uint32_t		columns;
+	mlx_tilefunc	func;
+	void*			param;
+}	mlx_tiles_t;
+
+/**
+ * Tiles rendered by threads of their own, so the main loop keeps going
+ * while they work. Threads take the next tile to render from a counter
+ * and hand the index of every finished tile to the main thread through
+ * a queue, which uploads them at the start of the next frame.
+ */
+struct mlx_progress
+{
+	mlx_tiles_t			tiles;
+	uint32_t			count;
+	_Atomic(uint32_t)	next;
+	_Atomic(uint32_t)	finished;
+	atomic_bool			cancel;
+	uint32_t			uploaded;
+	mlx_queue_t*		done;
+	pthread_t*			threads;
+	uint32_t			thread_count;
+};
+
+static mlx_rect_t mlx_tile_rect(const mlx_tiles_t* tiles, uint32_t index)
+{
+	const uint32_t x = (index % tiles->columns) * tiles->width;
+	const uint32_t y = (index / tiles->columns) * tiles->height;
+	const uint32_t width = tiles->image->width - x < tiles->width ? tiles->image->width - x : tiles->width;
+	const uint32_t height = tiles->image->height - y < tiles->height ? tiles->image->height - y : tiles->height;
+
+	return ((mlx_rect_t){x, y, x + width, y + height});
+}
+
+static void mlx_render_tile_task(void* param, uint32_t index)
+{
+	const mlx_tiles_t* tiles = param;
+	const mlx_rect_t rect = mlx_tile_rect(tiles, index);
+
+	tiles->func(tiles->image, rect.x0, rect.y0, rect.x1 - rect.x0, rect.y1 - rect.y0, tiles->param);
+}
+
+/**
+ * Splits an image into tiles, zero sized tiles get the default size.
+ * 
+ * @return The amount of tiles.
+ */
+static uint32_t mlx_split_tiles(mlx_tiles_t* tiles)
+{
+	if (tiles->width == 0)
+		tiles->width = MLX_PARALLEL_TILE;
+	if (tiles->height == 0)
+		tiles->height = MLX_PARALLEL_TILE;
+
+	tiles->columns = (tiles->image->width + (uint64_t)tiles->width - 1) / tiles->width;
+	const uint64_t rows = (tiles->image->height + (uint64_t)tiles->height - 1) / tiles->height;
+	MLX_ASSERT(tiles->columns * rows <= UINT32_MAX, "Too many tiles");
+	return (tiles->columns * rows);
+}
+
+static void* mlx_progress_worker(void* param)
+{
+	mlx_progress_t* const progress = param;
+	uint32_t index;
+
+	while (!atomic_load_explicit(&progress->cancel, memory_order_relaxed))
+	{
+		if ((index = atomic_fetch_add(&progress->next, 1)) >= progress->count)
+			break;
+		mlx_render_tile_task(&progress->tiles, index);
+
+		// Never full, it holds every tile. Pushing publishes the pixels.
+		mlx_queue_push(progress->done, &index);
+		atomic_fetch_add_explicit(&progress->finished, 1, memory_order_release);
+	}
+	return (NULL);
+}
+
+/**
+ * Whether an image has tiles rendered in the background that still have
+ * to be uploaded, in which case they're uploaded instead of the dirty rect.
+ */
+bool mlx_progress_pending(const mlx_image_t* img)
+{
+	const mlx_progress_t* progress = ((mlx_image_ctx_t*)img->context)->progress;
+
+	return (progress && progress->uploaded < progress->count);
+}
+
+/**
+ * Uploads the tiles that were finished since the last frame, one by one.
+ * Streamed images upload the region covering them in one go instead, as
+ * every upload of those takes another buffer of the ring.
+ * 
+ * @returns The amount of bytes that were uploaded.
+ */
+size_t mlx_upload_progress(mlx_image_t* img)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+	mlx_progress_t* const progress = imgctx->progress;
+	mlx_rect_t bounds = {UINT32_MAX, UINT32_MAX, 0, 0};
+	size_t bytes = 0;
+	uint32_t index;
+
+	while (mlx_queue_pop(progress->done, &index))
+	{
+		const mlx_rect_t rect = mlx_tile_rect(&progress->tiles, index);
+
+		progress->uploaded++;
+		if (!imgctx->stream)
+		{
+			bytes += mlx_upload_rect(img, rect);
+			continue;
+		}
+		bounds.x0 = rect.x0 < bounds.x0 ? rect.x0 : bounds.x0;
+		bounds.y0 = rect.y0 < bounds.y0 ? rect.y0 : bounds.y0;
+		bounds.x1 = rect.x1 > bounds.x1 ? rect.x1 : bounds.x1;
+		bounds.y1 = rect.y1 > bounds.y1 ? rect.y1 : bounds.y1;
+	}
+	if (bounds.x0 < bounds.x1)
+		bytes += mlx_upload_rect(img, bounds);
+	return (bytes);
+}
+
+/**
+ * Stops the threads rendering an image in the background, if any, such
+ * as before the pixels go away. The tiles they're working on are still
+ * finished, those that were never uploaded are marked as modified.
+ */
+void mlx_delete_progress(mlx_image_t* img)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+	mlx_progress_t* const progress = imgctx->progress;
+
+	if (!progress)
+		return;
+	atomic_store(&progress->cancel, true);
+	for (uint32_t i = 0; i < progress->thread_count; i++)
+		pthread_join(progress->threads[i], NULL);
+
+	uint32_t index;
+	while (mlx_queue_pop(progress->done, &index))
+	{
+		const mlx_rect_t rect = mlx_tile_rect(&progress->tiles, index);
+		mlx_image_mark_dirty(img, rect.x0, rect.y0, rect.x1 - rect.x0, rect.y1 - rect.y0);
+	}
+	mlx_delete_queue(progress->done);
+	mlx_freen(2, progress->threads, progress);
+	imgctx->progress = NULL;
+}
+
+/**
+ * Joins the threads of images that are done rendering in the background,
+ * so they don't linger until the image goes away. Runs at the start of a
+ * frame, tiles that weren't uploaded yet are marked as modified instead.
+ */
+void mlx_reap_progress(mlx_ctx_t* mlx)
+{
+	for (mlx_list_t* entry = mlx->images; entry; entry = entry->next)
+	{
+		if (mlx_progressive_done(entry->content))
+			mlx_delete_progress(entry->content);
+	}
+}
+
+//= Public =//
+
+bool mlx_parallel_tiles(mlx_t* mlx, mlx_image_t* image, uint32_t tile_width, uint32_t tile_height, mlx_tilefunc func, void* param)
+{
+	MLX_NONNULL(mlx);
+	MLX_NONNULL(image);
+	MLX_NONNULL(func);
+
+	if (image->width == 0 || image->height == 0)
+		return (true);
+
+	mlx_tiles_t tiles = {image, tile_width, tile_height, 0, func, param};
+	const uint32_t count = mlx_split_tiles(&tiles);
+
+	mlx_pool_t* pool;
+	if (!(pool = mlx_get_pool(mlx->context)))
+		return (false);
+	mlx_pool_run(pool, mlx_render_tile_task, &tiles, count);
+	mlx_image_mark_dirty(image, 0, 0, image->width, image->height);
+	return (true);
+}
+
+bool mlx_progressive_tiles(mlx_image_t* image, uint32_t tile_width, uint32_t tile_height, mlx_tilefunc func, void* param)
+{
+	MLX_NONNULL(image);
+	MLX_NONNULL(func);
+
+	mlx_image_ctx_t* const imgctx = image->context;
+	mlx_delete_progress(image);
+	if (image->width == 0 || image->height == 0)
+		return (true);
+
+	mlx_progress_t* progress;
+	if (!(progress = calloc(1, sizeof(mlx_progress_t))))
+		return (mlx_error(MLX_MEMFAIL));
+	progress->tiles = (mlx_tiles_t){image, tile_width, tile_height, 0, func, param};
+	progress->count = mlx_split_tiles(&progress->tiles);
+	atomic_init(&progress->next, 0);
+	atomic_init(&progress->finished, 0);
+	atomic_init(&progress->cancel, false);
+
+	const uint32_t threads = mlx_thread_count();
+	progress->done = mlx_new_queue(progress->count, sizeof(uint32_t));
+	progress->threads = calloc(threads, sizeof(pthread_t));
+	if (!progress->done || !progress->threads)
+	{
+		mlx_delete_queue(progress->done);
+		mlx_freen(2, progress->threads, progress);
+		return (mlx_error(MLX_MEMFAIL));
+	}
+
+	// Running with fewer threads than asked for still works, just slower.
+	for (uint32_t i = 0; i < threads; i++)
+	{
+		if (pthread_create(&progress->threads[i], NULL, mlx_progress_worker, progress) != 0)
+			break;
+		progress->thread_count++;
+	}
+	imgctx->progress = progress;
+	if (progress->thread_count == 0)
+		return (mlx_delete_progress(image), mlx_error(MLX_MEMFAIL));
+
+	// Every pixel is uploaded along with its tile.
+	mlx_clear_dirty(image);
+	return (true);
+}
+
+bool mlx_progressive_done(const mlx_image_t* image)
+{
+	MLX_NONNULL(image);
+
+	const mlx_progress_t* progress = ((mlx_image_ctx_t*)image->context)->progress;
+	return (!progress || atomic_load_explicit(&progress->finished, memory_order_acquire) == progress->count);
+}
+
+void mlx_progressive_cancel(mlx_image_t* image)
+{
+	MLX_NONNULL(image);
+
+	mlx_delete_progress(image);
+}
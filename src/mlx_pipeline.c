@@ -0,0 +1,440 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_pipeline.c                                     :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 08:00:57 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:24:14 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+#include <pthread.h>
+
+//= Private =//
+
+// Region staged for upload, its pixels are packed tightly in the staging memory.
+typedef struct mlx_upload
+{
+	GLuint		texture;
+	bool		array;
+	uint32_t	layer;
+	uint32_t	x;
+	uint32_t	y;
+	uint32_t	width;
+	uint32_t	height;
+	size_t		offset;
+}	mlx_upload_t;
+
+/**
+ * Snapshot of everything the render thread needs to draw a frame.
+ *
+ * The instances are copied in the order of the render queue, so the render
+ * thread never looks at the instances the hooks are busy changing. Disabled
+ * images have all of their instances disabled in the copy.
+ */
+typedef struct mlx_frame
+{
+	draw_queue_t*	queue;
+	mlx_instance_t*	instances;
+	size_t			count;
+	size_t			capacity;
+	mlx_upload_t*	uploads;
+	size_t			upload_count;
+	size_t			upload_capacity;
+	uint8_t*		staging;
+	size_t			staged;
+	size_t			staging_capacity;
+	int32_t			width;
+	int32_t			height;
+	int32_t			depth;
+	uint8_t*		read_target;
+}	mlx_frame_t;
+
+/**
+ * The render thread owns the context and draws frame N, while the main
+ * thread polls events and runs the hooks of frame N + 1.
+ *
+ * A frame is handed over once the render thread is done with the previous
+ * one, so there is only ever one snapshot. Whenever the main thread needs
+ * the context itself it borrows it in between frames, see mlx_acquire_context.
+ */
+struct mlx_pipeline
+{
+	mlx_t*				mlx;
+	pthread_t			thread;
+	pthread_mutex_t		lock;
+	pthread_cond_t		wake;
+	pthread_cond_t		idle;
+	bool				pending;
+	bool				rendering;
+	bool				quit;
+	uint32_t			borrowed;
+	mlx_frame_t			frame;
+	mlx_frame_stats_t	stats;
+};
+
+static void mlx_wait_idle(mlx_pipeline_t* pipe)
+{
+	pthread_mutex_lock(&pipe->lock);
+	while (pipe->pending || pipe->rendering)
+		pthread_cond_wait(&pipe->idle, &pipe->lock);
+	pthread_mutex_unlock(&pipe->lock);
+}
+
+static void mlx_upload_staged(mlx_ctx_t* mlx, const mlx_frame_t* frame)
+{
+	const double start = mlx_trace_begin(mlx);
+
+	for (size_t i = 0; i < frame->upload_count; i++)
+	{
+		const mlx_upload_t* upload = &frame->uploads[i];
+		const uint8_t* pixels = frame->staging + upload->offset;
+
+		if (upload->array)
+		{
+			glBindTexture(GL_TEXTURE_2D_ARRAY, upload->texture);
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, upload->x, upload->y, upload->layer, upload->width, upload->height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+			continue;
+		}
+		glBindTexture(GL_TEXTURE_2D, upload->texture);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, upload->x, upload->y, upload->width, upload->height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+	}
+	if (frame->upload_count > 0)
+		mlx_trace_end(mlx, "upload", frame->staging, start, frame->staged);
+}
+
+// Adds the time passed since the mark to the phase, returning the new mark.
+static double mlx_render_phase(double mark, double* phase)
+{
+	const double now = glfwGetTime();
+
+	*phase += (now - mark) * 1000.0;
+	return (now);
+}
+
+/**
+ * Draws the snapshot and presents it, the counters go into the stats of the
+ * pipeline which the main thread picks up once the frame is done.
+ */
+static void mlx_render_frame(mlx_pipeline_t* pipe)
+{
+	mlx_t* const mlx = pipe->mlx;
+	mlx_ctx_t* const mlxctx = mlx->context;
+	const mlx_frame_t* frame = &pipe->frame;
+	mlx_frame_stats_t* const stats = &pipe->stats;
+	const size_t pushed = mlxctx->vertices.pushed;
+	double mark = glfwGetTime();
+
+	glfwMakeContextCurrent(mlx->window);
+	glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	if (frame->width > 1 || frame->height > 1)
+		mlx_update_matrix(mlx, frame->width, frame->height, frame->depth);
+	mlx_upload_staged(mlxctx, frame);
+	mark = mlx_render_phase(mark, &stats->upload_time);
+
+	mlx_draw_queue(mlxctx, frame->queue, frame->instances, frame->count);
+	mlx_flush_batch(mlxctx);
+	mlx_issue_read(mlxctx, frame->read_target);
+	mark = mlx_render_phase(mark, &stats->draw_time);
+
+	const double swap = mlx_trace_begin(mlxctx);
+	if (mlxctx->fbo)
+		glFlush();
+	else
+		glfwSwapBuffers(mlx->window);
+	mlx_trace_end(mlxctx, "swap", mlx->window, swap, 0);
+	mlx_sync_reads(mlxctx, false);
+	mlx_render_phase(mark, &stats->swap_time);
+	stats->vertex_bytes += mlxctx->vertices.pushed - pushed;
+	glfwMakeContextCurrent(NULL);
+}
+
+static void* mlx_render_thread(void* param)
+{
+	mlx_pipeline_t* const pipe = param;
+
+	pthread_mutex_lock(&pipe->lock);
+	while (true)
+	{
+		while (!pipe->pending && !pipe->quit)
+			pthread_cond_wait(&pipe->wake, &pipe->lock);
+
+		// A frame that was already handed over is still drawn before quitting.
+		if (!pipe->pending)
+			break;
+		pipe->pending = false;
+		pipe->rendering = true;
+		pthread_mutex_unlock(&pipe->lock);
+		mlx_render_frame(pipe);
+		pthread_mutex_lock(&pipe->lock);
+		pipe->rendering = false;
+		pthread_cond_broadcast(&pipe->idle);
+	}
+	pthread_mutex_unlock(&pipe->lock);
+	return (NULL);
+}
+
+/**
+ * Adds the counters of the frame the render thread finished to the current
+ * one. They are a frame behind, just like the GPU time.
+ */
+static void mlx_collect_rendered(mlx_pipeline_t* pipe, mlx_stats_t* frame)
+{
+	mlx_frame_stats_t* const rendered = &pipe->stats;
+	mlx_frame_stats_t* const stats = &frame->current;
+
+	if (frame->active)
+	{
+		stats->upload_time += rendered->upload_time;
+		stats->draw_time += rendered->draw_time;
+		stats->swap_time += rendered->swap_time;
+	}
+	stats->draw_calls += rendered->draw_calls;
+	stats->batches += rendered->batches;
+	stats->instances += rendered->instances;
+	stats->vertex_bytes += rendered->vertex_bytes;
+	memset(rendered, 0, sizeof(mlx_frame_stats_t));
+}
+
+static bool mlx_grow_frame(mlx_frame_t* frame, size_t count)
+{
+	if (count <= frame->capacity)
+		return (true);
+
+	draw_queue_t* queue;
+	mlx_instance_t* instances;
+	if (!(queue = realloc(frame->queue, count * sizeof(draw_queue_t))))
+		return (false);
+	frame->queue = queue;
+	if (!(instances = realloc(frame->instances, count * sizeof(mlx_instance_t))))
+		return (false);
+	frame->instances = instances;
+	frame->capacity = count;
+	return (true);
+}
+
+/**
+ * Copies the sorted render queue and the instances it points at, if that
+ * fails the frame is drawn empty but the uploads still go through.
+ */
+static void mlx_snapshot_queue(mlx_ctx_t* mlx, mlx_frame_t* frame)
+{
+	frame->count = 0;
+	if (!mlx_grow_frame(frame, mlx->render_count))
+		return ((void)mlx_error(MLX_MEMFAIL));
+
+	memcpy(frame->queue, mlx->render_queue, mlx->render_count * sizeof(draw_queue_t));
+	for (size_t i = 0; i < mlx->render_count; i++)
+	{
+		const draw_queue_t* drawcall = &mlx->render_queue[i];
+
+		frame->instances[i] = drawcall->image->instances[drawcall->instanceid];
+		frame->instances[i].enabled = frame->instances[i].enabled && drawcall->image->enabled;
+	}
+	frame->count = mlx->render_count;
+}
+
+// Makes room for another upload of the given size.
+static bool mlx_reserve_upload(mlx_frame_t* frame, size_t size)
+{
+	if (frame->upload_count >= frame->upload_capacity)
+	{
+		const size_t capacity = frame->upload_capacity ? frame->upload_capacity * 2 : 64;
+		mlx_upload_t* uploads;
+		if (!(uploads = realloc(frame->uploads, capacity * sizeof(mlx_upload_t))))
+			return (false);
+		frame->uploads = uploads;
+		frame->upload_capacity = capacity;
+	}
+	if (frame->staged + size > frame->staging_capacity)
+	{
+		size_t capacity = frame->staging_capacity ? frame->staging_capacity : size;
+		while (capacity < frame->staged + size)
+			capacity *= 2;
+		uint8_t* staging;
+		if (!(staging = realloc(frame->staging, capacity)))
+			return (false);
+		frame->staging = staging;
+		frame->staging_capacity = capacity;
+	}
+	return (true);
+}
+
+// Atlas pages are only ever repacked with the context borrowed.
+static void mlx_stage_atlases(mlx_ctx_t* mlx)
+{
+	for (mlx_list_t* lst = mlx->atlases; lst; lst = lst->next)
+	{
+		if (!((mlx_atlas_t*)lst->content)->repack)
+			continue;
+		mlx_acquire_context(mlx);
+		mlx_repack_atlases(mlx);
+		mlx_release_context(mlx);
+		return;
+	}
+}
+
+//= Public =//
+
+/**
+ * Starts the render thread, which takes the context off the main thread.
+ * If the thread can't be started the loop simply isn't pipelined.
+ */
+bool mlx_create_pipeline(mlx_t* mlx)
+{
+	mlx_ctx_t* const mlxctx = mlx->context;
+
+	mlx_pipeline_t* pipe;
+	if (!(pipe = calloc(1, sizeof(mlx_pipeline_t))))
+		return (mlx_error(MLX_MEMFAIL));
+	pipe->mlx = mlx;
+	pthread_mutex_init(&pipe->lock, NULL);
+	pthread_cond_init(&pipe->wake, NULL);
+	pthread_cond_init(&pipe->idle, NULL);
+
+	// A context can only be current on one thread at a time.
+	glfwMakeContextCurrent(NULL);
+	if (pthread_create(&pipe->thread, NULL, mlx_render_thread, pipe) != 0)
+	{
+		glfwMakeContextCurrent(mlx->window);
+		pthread_cond_destroy(&pipe->idle);
+		pthread_cond_destroy(&pipe->wake);
+		pthread_mutex_destroy(&pipe->lock);
+		free(pipe);
+		return (true);
+	}
+	mlxctx->pipeline = pipe;
+	mlxctx->stats.render = &pipe->stats;
+	return (true);
+}
+
+/**
+ * Hands the frame over to the render thread once it's done with the
+ * previous one. Until then the main thread can't touch the snapshot.
+ *
+ * The pixels of the images are staged here as well, so that the hooks
+ * of the next frame can keep on drawing into them.
+ */
+void mlx_submit_frame(mlx_t* mlx)
+{
+	mlx_ctx_t* const mlxctx = mlx->context;
+	mlx_pipeline_t* const pipe = mlxctx->pipeline;
+	mlx_frame_t* const frame = &pipe->frame;
+	mlx_frame_stats_t* const stats = &mlxctx->stats.current;
+
+	mlx_wait_idle(pipe);
+	mlx_collect_rendered(pipe, &mlxctx->stats);
+	mlx_stats_phase(mlxctx, NULL);
+
+	// Reclaim the atlas space of images that were deleted or resized
+	mlx_stage_atlases(mlxctx);
+	frame->upload_count = 0;
+	frame->staged = 0;
+	for (mlx_list_t* imglst = mlxctx->images; imglst; imglst = imglst->next)
+	{
+		mlx_image_t* const image = imglst->content;
+		const double start = mlx_trace_begin(mlxctx);
+		const size_t bytes = mlx_upload_image(image);
+		if (bytes > 0)
+			mlx_trace_end(mlxctx, "stage", image, start, bytes);
+		stats->upload_bytes += bytes;
+	}
+	mlx_snapshot_queue(mlxctx, frame);
+	frame->width = mlx->width;
+	frame->height = mlx->height;
+	frame->depth = mlxctx->zdepth;
+	frame->read_target = mlxctx->read_target;
+	mlxctx->read_target = NULL;
+	mlx_stats_phase(mlxctx, &stats->upload_time);
+
+	pthread_mutex_lock(&pipe->lock);
+	pipe->pending = true;
+	pthread_cond_signal(&pipe->wake);
+	pthread_mutex_unlock(&pipe->lock);
+}
+
+/**
+ * Copies a region of an image for the render thread to upload, see
+ * mlx_upload_rect.
+ *
+ * @returns The amount of bytes that were staged.
+ */
+size_t mlx_stage_rect(mlx_image_t* img, mlx_rect_t rect)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+	mlx_frame_t* const frame = &imgctx->mlx->pipeline->frame;
+	const uint32_t width = rect.x1 - rect.x0;
+	const uint32_t height = rect.y1 - rect.y0;
+	const size_t pitch = (size_t)width * BPP;
+
+	if (!mlx_reserve_upload(frame, pitch * height))
+		return (mlx_error(MLX_MEMFAIL), 0);
+
+	const uint8_t* front = mlx_front_pixels(img);
+	uint8_t* dst = frame->staging + frame->staged;
+	for (uint32_t y = rect.y0; y < rect.y1; y++, dst += pitch)
+		memcpy(dst, &front[(y * img->width + rect.x0) * BPP], pitch);
+
+	frame->uploads[frame->upload_count++] = (mlx_upload_t){
+		imgctx->texture, imgctx->group != NULL, imgctx->layer,
+		imgctx->atlas_x + rect.x0, imgctx->atlas_y + rect.y0, width, height, frame->staged
+	};
+	frame->staged += pitch * height;
+	return (pitch * height);
+}
+
+/**
+ * Makes the context current on the main thread, waiting for the render
+ * thread to finish its frame first. Calls nest, the context goes back
+ * with the outermost mlx_release_context.
+ *
+ * Does nothing unless the loop is pipelined.
+ */
+void mlx_acquire_context(mlx_ctx_t* mlx)
+{
+	mlx_pipeline_t* const pipe = mlx->pipeline;
+
+	if (!pipe || pipe->borrowed++ > 0)
+		return;
+	mlx_wait_idle(pipe);
+	glfwMakeContextCurrent(pipe->mlx->window);
+}
+
+void mlx_release_context(mlx_ctx_t* mlx)
+{
+	mlx_pipeline_t* const pipe = mlx->pipeline;
+
+	if (!pipe || --pipe->borrowed > 0)
+		return;
+	glfwMakeContextCurrent(NULL);
+}
+
+/**
+ * Stops the render thread after it drew the frame it was handed, the
+ * context is made current on the main thread again.
+ */
+void mlx_delete_pipeline(mlx_ctx_t* mlx)
+{
+	mlx_pipeline_t* const pipe = mlx->pipeline;
+
+	if (!pipe)
+		return;
+	pthread_mutex_lock(&pipe->lock);
+	pipe->quit = true;
+	pthread_cond_signal(&pipe->wake);
+	pthread_mutex_unlock(&pipe->lock);
+	pthread_join(pipe->thread, NULL);
+
+	glfwMakeContextCurrent(pipe->mlx->window);
+	mlx->pipeline = NULL;
+	mlx->stats.render = &mlx->stats.current;
+	pthread_cond_destroy(&pipe->idle);
+	pthread_cond_destroy(&pipe->wake);
+	pthread_mutex_destroy(&pipe->lock);
+	mlx_freen(5, pipe->frame.queue, pipe->frame.instances, pipe->frame.uploads, \
+		pipe->frame.staging, pipe);
+}
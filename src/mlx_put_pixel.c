@@ -6,19 +6,21 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2021/12/28 03:30:13 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/06/29 16:00:30 by lde-la-h      ########   odam.nl         */
+/*   Updated: 2026/10/18 08:28:28 by W2Wizard      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "MLX42/MLX42_Int.h"
 
-// BUG: Linux may experience a red hue instead due to endiannes
+// Stores the RGBA bytes of the color with a single write, like mlx_put_pixel_unsafe.
 void mlx_draw_pixel(uint8_t* pixel, uint32_t color)
 {
-	*(pixel++) = (uint8_t)(color >> 24);
-	*(pixel++) = (uint8_t)(color >> 16);
-	*(pixel++) = (uint8_t)(color >> 8);
-	*(pixel++) = (uint8_t)(color & 0xFF);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	const uint32_t value = color;
+#else
+	const uint32_t value = color >> 24 | (color >> 8 & 0xFF00) | (color << 8 & 0xFF0000) | color << 24;
+#endif
+	memcpy(pixel, &value, sizeof(value));
 }
 
 //= Public =//
@@ -29,6 +31,6 @@ void mlx_put_pixel(mlx_image_t* image, uint32_t x, uint32_t y, uint32_t color)
 	MLX_ASSERT(x < image->width, "Pixel is out of bounds");
 	MLX_ASSERT(y < image->height, "Pixel is out of bounds");
 
-	uint8_t* pixelstart = &image->pixels[(y * image->width + x) * BPP];
-	mlx_draw_pixel(pixelstart, color);
+	mlx_put_pixel_unsafe(image, x, y, color);
+	mlx_image_mark_dirty(image, x, y, 1, 1);
 }
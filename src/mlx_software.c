@@ -0,0 +1,170 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_software.c                                     :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:58:00 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:28:05 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+//= Private =//
+
+/**
+ * The framebuffer of the software backend, composited on the CPU
+ * one horizontal tile at a time, spread over the pool of threads.
+ * 
+ * With MLX_STRETCH_IMAGE it keeps the initial size of the window and is
+ * scaled up or down to the size of the window when read, like OpenGL.
+ */
+struct mlx_software
+{
+	uint8_t*	pixels;
+	int32_t		width;
+	int32_t		height;
+	int32_t		window_width;
+	int32_t		window_height;
+	mlx_ctx_t*	mlx;
+};
+
+/**
+ * Composites a single tile, drawing the render queue back to front
+ * which is already sorted by depth.
+ */
+static void mlx_render_tile(void* param, uint32_t index)
+{
+	const mlx_software_t* software = param;
+	const mlx_ctx_t* mlx = software->mlx;
+	const int32_t top = index * MLX_TILE_SIZE;
+	const int32_t bottom = top + MLX_TILE_SIZE < software->height ? top + MLX_TILE_SIZE : software->height;
+	const size_t pitch = software->width * BPP;
+
+	// Same background as the OpenGL backend clears to.
+	uint32_t background;
+	mlx_draw_pixel((uint8_t*)&background, 0x333333FF);
+	mlx_kernels.fill(&software->pixels[top * pitch], background, (size_t)(bottom - top) * software->width);
+
+	for (size_t i = 0; i < mlx->render_count; i++)
+	{
+		const mlx_image_t* img = mlx->render_queue[i].image;
+		const mlx_instance_t* instance = &img->instances[mlx->render_queue[i].instanceid];
+		if (!img->enabled || !instance->enabled)
+			continue;
+
+		const int32_t x0 = instance->x > 0 ? instance->x : 0;
+		const int32_t y0 = instance->y > top ? instance->y : top;
+		const int32_t x1 = instance->x + (int32_t)img->width < software->width ? instance->x + (int32_t)img->width : software->width;
+		const int32_t y1 = instance->y + (int32_t)img->height < bottom ? instance->y + (int32_t)img->height : bottom;
+		if (x0 >= x1 || y0 >= y1)
+			continue;
+
+		const uint8_t* pixels = mlx_front_pixels(img);
+		for (int32_t y = y0; y < y1; y++)
+		{
+			const uint8_t* src = &pixels[((y - instance->y) * img->width + (x0 - instance->x)) * BPP];
+			mlx_kernels.blit(&software->pixels[y * pitch + x0 * BPP], src, x1 - x0, MLX_BLEND_ALPHA);
+		}
+	}
+}
+
+static bool mlx_resize_software(mlx_software_t* software, int32_t width, int32_t height)
+{
+	if (width == software->width && height == software->height)
+		return (true);
+
+	uint8_t* pixels;
+	if (!(pixels = realloc(software->pixels, (size_t)width * height * BPP)))
+		return (mlx_error(MLX_MEMFAIL));
+	software->pixels = pixels;
+	software->width = width;
+	software->height = height;
+	return (true);
+}
+
+//= Public =//
+
+bool mlx_create_software(mlx_ctx_t* mlx, int32_t width, int32_t height)
+{
+	mlx_software_t* software;
+	if (!(software = calloc(1, sizeof(mlx_software_t))))
+		return (mlx_error(MLX_MEMFAIL));
+
+	mlx->software = software;
+	software->mlx = mlx;
+	software->window_width = width;
+	software->window_height = height;
+	if (!mlx_get_pool(mlx))
+		return (false);
+	return (mlx_resize_software(software, width, height));
+}
+
+/**
+ * Renders a frame of the software backend, the counterpart of uploading
+ * and drawing all images with OpenGL.
+ */
+void mlx_render_software(mlx_ctx_t* mlx, int32_t width, int32_t height)
+{
+	mlx_software_t* const software = mlx->software;
+
+	if (width <= 0 || height <= 0)
+		return;
+	software->window_width = width;
+	software->window_height = height;
+	if (mlx_settings[MLX_STRETCH_IMAGE])
+	{
+		width = mlx->initialWidth;
+		height = mlx->initialHeight;
+	}
+	if (!mlx_resize_software(software, width, height))
+		return;
+
+	// Take the pixels that were published by other threads since the last frame.
+	for (mlx_list_t* imglst = mlx->images; imglst; imglst = imglst->next)
+		mlx_acquire_front(imglst->content);
+
+	const uint32_t tiles = (software->height + MLX_TILE_SIZE - 1) / MLX_TILE_SIZE;
+	mlx_pool_run(mlx->pool, mlx_render_tile, software, tiles);
+	mlx->stats.current.instances += mlx->render_count;
+}
+
+/**
+ * Copies the current frame of the software backend, which unlike
+ * the OpenGL one is already done once it's rendered. A stretched frame
+ * is sampled at the center of every pixel of the window, the nearest
+ * pixel wins just like it does for the textures.
+ */
+void mlx_read_software(mlx_ctx_t* mlx, uint8_t* dst)
+{
+	const mlx_software_t* software = mlx->software;
+	const int32_t width = software->window_width;
+	const int32_t height = software->window_height;
+
+	if (width == software->width && height == software->height)
+	{
+		memcpy(dst, software->pixels, (size_t)width * height * BPP);
+		return;
+	}
+	for (int32_t y = 0; y < height; y++)
+	{
+		const int64_t row = (2 * (int64_t)y + 1) * software->height / (2 * height);
+		for (int32_t x = 0; x < width; x++)
+		{
+			const int64_t col = (2 * (int64_t)x + 1) * software->width / (2 * width);
+			memcpy(&dst[((size_t)y * width + x) * BPP], &software->pixels[(row * software->width + col) * BPP], BPP);
+		}
+	}
+}
+
+void mlx_delete_software(mlx_ctx_t* mlx)
+{
+	mlx_software_t* const software = mlx->software;
+
+	if (!software)
+		return;
+	mlx_freen(2, software->pixels, software);
+	mlx->software = NULL;
+}
@@ -0,0 +1,155 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_stats.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:50:05 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:24:14 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+//= Private =//
+
+/**
+ * Reads back the results of the timer queries that have finished,
+ * the most recent of them becomes the GPU time of the frame.
+ */
+static void mlx_collect_queries(mlx_stats_t* stats)
+{
+	while (stats->collected < stats->issued)
+	{
+		const GLuint query = stats->queries[stats->collected % MLX_STATS_QUERIES];
+
+		GLint available = 0;
+		glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+		if (!available)
+			break;
+
+		GLuint64 elapsed = 0;
+		glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+		stats->current.gpu_time = elapsed / 1000000.0;
+		stats->collected++;
+	}
+}
+
+static void mlx_record_frame(mlx_stats_t* stats, double frame_time)
+{
+	uint32_t bucket = (uint32_t)frame_time;
+	if (bucket >= MLX_HISTOGRAM_SIZE)
+		bucket = MLX_HISTOGRAM_SIZE - 1;
+
+	// Once the history is full the oldest frame makes room for the new one.
+	uint8_t* slot = &stats->history[stats->frames % MLX_STATS_HISTORY];
+	if (stats->frames >= MLX_STATS_HISTORY)
+		stats->histogram[*slot]--;
+	*slot = bucket;
+	stats->histogram[bucket]++;
+	stats->frames++;
+}
+
+//= Public =//
+
+/**
+ * Starts collecting the stats of a new frame.
+ * 
+ * The GPU time of a frame is only known a couple of frames later, so until
+ * a new result comes in the previous one is carried over.
+ */
+void mlx_stats_begin(mlx_ctx_t* mlx)
+{
+	mlx_stats_t* const stats = &mlx->stats;
+	const double gpu_time = stats->last.gpu_time;
+
+	memset(&stats->current, 0, sizeof(stats->current));
+	stats->current.gpu_time = gpu_time;
+	if (!mlx->pipeline)
+		stats->pushed = mlx->vertices.pushed;
+	stats->querying = false;
+	if (!(stats->active = mlx_settings[MLX_FRAME_STATS]))
+	{
+		stats->current.gpu_time = -1;
+		return;
+	}
+
+	stats->start = glfwGetTime();
+	stats->mark = stats->start;
+
+	// Without the context the GPU can't be timed, see mlx_pipeline.c.
+	if (mlx->software || mlx->pipeline)
+	{
+		stats->current.gpu_time = -1;
+		return;
+	}
+	if (!stats->queries[0])
+	{
+		glGenQueries(MLX_STATS_QUERIES, stats->queries);
+		stats->current.gpu_time = -1;
+	}
+
+	// With every query still in flight this frame simply isn't measured.
+	if ((stats->querying = stats->issued - stats->collected < MLX_STATS_QUERIES))
+		glBeginQuery(GL_TIME_ELAPSED, stats->queries[stats->issued % MLX_STATS_QUERIES]);
+}
+
+/**
+ * Ends the current phase of the frame, adding the time passed since
+ * the previous phase ended to it.
+ * 
+ * @param mlx The MLX instance context.
+ * @param phase The phase timing to add to, or NULL to skip over a phase.
+ */
+void mlx_stats_phase(mlx_ctx_t* mlx, double* phase)
+{
+	if (!mlx->stats.active)
+		return;
+
+	const double now = glfwGetTime();
+	if (phase)
+		*phase += (now - mlx->stats.mark) * 1000.0;
+	mlx->stats.mark = now;
+}
+
+/**
+ * Finishes the stats of the current frame and publishes them.
+ */
+void mlx_stats_end(mlx_ctx_t* mlx)
+{
+	mlx_stats_t* const stats = &mlx->stats;
+
+	if (!mlx->pipeline)
+		stats->current.vertex_bytes = mlx->vertices.pushed - stats->pushed;
+	if (stats->querying)
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		stats->issued++;
+	}
+	if (stats->active && stats->queries[0])
+		mlx_collect_queries(stats);
+	if (stats->active)
+	{
+		stats->current.frame_time = (glfwGetTime() - stats->start) * 1000.0;
+		mlx_record_frame(stats, stats->current.frame_time);
+	}
+	stats->last = stats->current;
+}
+
+void mlx_get_frame_stats(mlx_t* mlx, mlx_frame_stats_t* stats)
+{
+	MLX_NONNULL(mlx);
+	MLX_NONNULL(stats);
+
+	*stats = ((mlx_ctx_t*)mlx->context)->stats.last;
+}
+
+void mlx_get_frame_histogram(mlx_t* mlx, uint32_t histogram[MLX_HISTOGRAM_SIZE])
+{
+	MLX_NONNULL(mlx);
+	MLX_NONNULL(histogram);
+
+	const mlx_stats_t* stats = &((mlx_ctx_t*)mlx->context)->stats;
+	memcpy(histogram, stats->histogram, sizeof(stats->histogram));
+}
@@ -0,0 +1,316 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_stream.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:28:56 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:03:48 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+//= Private =//
+
+/**
+ * Waits for the GPU to pass the given fence and deletes it.
+ * 
+ * @param sync The fence to wait on, set to NULL afterwards.
+ */
+void mlx_wait_sync(GLsync* sync)
+{
+	if (*sync == NULL)
+		return;
+
+	GLenum status;
+	do
+		status = glClientWaitSync(*sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+	while (status == GL_TIMEOUT_EXPIRED);
+	glDeleteSync(*sync);
+	*sync = NULL;
+}
+
+/**
+ * Creates a persistently mapped buffer of the given size as the only buffer
+ * of the stream, the mapping stays valid until the buffer is deleted.
+ * 
+ * The mapping is flushed explicitly right before each upload, so only the
+ * modified region has to be made visible to the GPU.
+ */
+static bool mlx_map_stream(mlx_stream_t* stream, size_t size)
+{
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT;
+
+	glGenBuffers(1, &stream->buffers[0]);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stream->buffers[0]);
+	glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, NULL, flags);
+	stream->mapping = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, flags | GL_MAP_FLUSH_EXPLICIT_BIT);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	if (!stream->mapping)
+		glDeleteBuffers(1, &stream->buffers[0]);
+	return (stream->mapping != NULL);
+}
+
+static void mlx_unmap_stream(mlx_stream_t* stream)
+{
+	mlx_wait_sync(&stream->fences[0]);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stream->buffers[0]);
+	glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glDeleteBuffers(1, &stream->buffers[0]);
+	stream->mapping = NULL;
+}
+
+/**
+ * Waits for the GPU to be done reading the mapped images, after which the
+ * user can safely write into their pixels again.
+ * 
+ * This is a synchronous wait on the frame just submitted: the mapping is the
+ * one and only copy of the pixels, so it can't be double buffered without
+ * copying them, which is what the ring does. Only images that were uploaded
+ * this frame have a fence to wait on.
+ */
+void mlx_sync_streams(mlx_ctx_t* mlx)
+{
+	for (mlx_list_t* imglst = mlx->images; imglst; imglst = imglst->next)
+	{
+		mlx_stream_t* const stream = ((mlx_image_ctx_t*)((mlx_image_t*)imglst->content)->context)->stream;
+
+		if (stream && stream->mapping)
+			mlx_wait_sync(&stream->fences[0]);
+	}
+}
+
+/**
+ * Resizes a mapped image by mapping a new buffer of the new size,
+ * like realloc the previous data is copied over.
+ */
+bool mlx_resize_mapping(mlx_image_t* img, uint32_t nwidth, uint32_t nheight)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+	mlx_stream_t* const stream = imgctx->stream;
+	const size_t oldsize = img->width * img->height * BPP;
+	const size_t newsize = nwidth * nheight * BPP;
+	mlx_wait_sync(&stream->fences[0]);
+
+	mlx_stream_t oldstream = *stream;
+	if (!mlx_map_stream(stream, newsize))
+	{
+		*stream = oldstream;
+		return (mlx_error(MLX_MEMFAIL));
+	}
+	memcpy(stream->mapping, oldstream.mapping, oldsize < newsize ? oldsize : newsize);
+	mlx_unmap_stream(&oldstream);
+
+	img->pixels = stream->mapping;
+	(*(uint32_t*)&img->width) = nwidth;
+	(*(uint32_t*)&img->height) = nheight;
+	glDeleteTextures(1, &imgctx->texture);
+	mlx_create_texture(img);
+	return (true);
+}
+
+bool mlx_create_stream(mlx_image_t* img)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+
+	mlx_stream_t* stream;
+	if (!(stream = calloc(1, sizeof(mlx_stream_t))))
+		return (mlx_error(MLX_MEMFAIL));
+
+	glGenBuffers(MLX_STREAM_BUFFERS, stream->buffers);
+	for (size_t i = 0; i < MLX_STREAM_BUFFERS; i++)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stream->buffers[i]);
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, img->width * img->height * BPP, NULL, GL_STREAM_DRAW);
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	imgctx->stream = stream;
+	return (true);
+}
+
+void mlx_delete_stream(mlx_image_t* img)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+	mlx_stream_t* const stream = imgctx->stream;
+
+	if (!stream)
+		return;
+
+	// NOTE: Whoever deletes a mapped stream has to take care of the pixels.
+	if (stream->mapping)
+	{
+		mlx_unmap_stream(stream);
+		img->pixels = NULL;
+	}
+	for (size_t i = 0; i < MLX_STREAM_BUFFERS; i++)
+	{
+		if (stream->fences[i])
+			glDeleteSync(stream->fences[i]);
+	}
+	glDeleteBuffers(MLX_STREAM_BUFFERS, stream->buffers);
+	free(stream);
+	imgctx->stream = NULL;
+}
+
+/**
+ * Uploads the dirty region of an image through the next buffer in its ring.
+ * 
+ * The region is copied into the buffer at the same offset it has in the image,
+ * the texture is then updated from the buffer without the CPU having to wait
+ * for it. The buffer is only written to again once its fence has passed.
+ * 
+ * @param img The streaming image.
+ * @param dirty The region to upload, must not be empty.
+ */
+void mlx_stream_image(mlx_image_t* img, mlx_rect_t dirty)
+{
+	mlx_image_ctx_t* const imgctx = img->context;
+	mlx_stream_t* const stream = imgctx->stream;
+	const uint32_t slot = stream->index;
+	const size_t pitch = img->width * BPP;
+	const size_t offset = dirty.y0 * pitch;
+	const size_t length = (dirty.y1 - dirty.y0) * pitch;
+
+	// Mapped pixels are already in the buffer, just make them visible.
+	if (stream->mapping)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stream->buffers[0]);
+		glFlushMappedBufferRange(GL_PIXEL_UNPACK_BUFFER, offset, length);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, dirty.x0, dirty.y0, dirty.x1 - dirty.x0, dirty.y1 - dirty.y0, GL_RGBA, GL_UNSIGNED_BYTE, (void*)(uintptr_t)(offset + dirty.x0 * BPP));
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		if (stream->fences[0])
+			glDeleteSync(stream->fences[0]);
+		stream->fences[0] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		return;
+	}
+
+	stream->index = (slot + 1) % MLX_STREAM_BUFFERS;
+	mlx_wait_sync(&stream->fences[slot]);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stream->buffers[slot]);
+
+	// The fence already synchronized the buffer for us.
+	const GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+	uint8_t* mapped;
+	if (!(mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, offset, length, access)))
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, dirty.x0, dirty.y0, dirty.x1 - dirty.x0, dirty.y1 - dirty.y0, GL_RGBA, GL_UNSIGNED_BYTE, &img->pixels[offset + dirty.x0 * BPP]);
+		return;
+	}
+
+	if (dirty.x0 == 0 && dirty.x1 == img->width)
+		memcpy(mapped, &img->pixels[offset], length);
+	else
+	{
+		const size_t start = dirty.x0 * BPP;
+		const size_t span = (dirty.x1 - dirty.x0) * BPP;
+		for (size_t row = 0; row < length; row += pitch)
+			memcpy(mapped + row + start, &img->pixels[offset + row + start], span);
+	}
+	glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+	// With a buffer bound the pointer is an offset into the buffer instead.
+	const uintptr_t source = offset + dirty.x0 * BPP;
+	glTexSubImage2D(GL_TEXTURE_2D, 0, dirty.x0, dirty.y0, dirty.x1 - dirty.x0, dirty.y1 - dirty.y0, GL_RGBA, GL_UNSIGNED_BYTE, (void*)source);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	stream->fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+/**
+ * Moves an image into or out of streaming, see mlx_set_image_streaming.
+ */
+static bool mlx_toggle_stream(mlx_image_t* image, bool enable)
+{
+	mlx_image_ctx_t* const imgctx = image->context;
+
+	if (!enable && imgctx->stream && imgctx->stream->mapping)
+	{
+		// Move the pixels out of the mapping before it goes away.
+		const size_t size = image->width * image->height * BPP;
+		uint8_t* pixels;
+		if (!(pixels = malloc(size)))
+			return (mlx_error(MLX_MEMFAIL));
+		memcpy(pixels, image->pixels, size);
+		mlx_delete_stream(image);
+		image->pixels = pixels;
+		return (true);
+	}
+	if (!enable)
+		return (mlx_delete_stream(image), true);
+	mlx_unshare_texture(image);
+
+	// The render thread uploads staged copies, a ring would go unused.
+	if (imgctx->mlx->pipeline)
+		return (true);
+	return (mlx_create_stream(image));
+}
+
+/**
+ * Gives a new image the stream it uploads through, see mlx_new_streaming_image.
+ */
+static bool mlx_attach_stream(mlx_image_t* image)
+{
+	mlx_image_ctx_t* const imgctx = image->context;
+
+	mlx_unshare_texture(image);
+	if (imgctx->mlx->pipeline)
+		return (true);
+
+	// Persistent mapping requires GL 4.4, otherwise stream through the ring.
+	mlx_stream_t* stream = NULL;
+	const size_t size = image->width * image->height * BPP;
+	if (GLAD_GL_VERSION_4_4 && (stream = calloc(1, sizeof(mlx_stream_t))) && mlx_map_stream(stream, size))
+	{
+		memset(stream->mapping, 0, size);
+		free(image->pixels);
+		image->pixels = stream->mapping;
+		imgctx->stream = stream;
+		return (true);
+	}
+	free(stream);
+	return (mlx_create_stream(image));
+}
+
+//= Public =//
+
+bool mlx_set_image_streaming(mlx_image_t* image, bool enable)
+{
+	MLX_NONNULL(image);
+
+	// The software backend reads the pixels directly, there's nothing to stream.
+	mlx_image_ctx_t* const imgctx = image->context;
+	if ((imgctx->stream || mlx_settings[MLX_SOFTWARE]) && enable)
+		return (true);
+	if (!enable && !imgctx->stream)
+		return (true);
+
+	// Streaming moves the pixels, tiles rendered in the background can't follow.
+	mlx_delete_progress(image);
+	if (enable && !mlx_set_image_buffering(image, false))
+		return (false);
+	mlx_acquire_context(imgctx->mlx);
+	const bool toggled = mlx_toggle_stream(image, enable);
+	mlx_release_context(imgctx->mlx);
+	return (toggled);
+}
+
+mlx_image_t* mlx_new_streaming_image(mlx_t* mlx, uint32_t width, uint32_t height)
+{
+	MLX_NONNULL(mlx);
+
+	mlx_image_t* image;
+	if (!(image = mlx_new_image(mlx, width, height)))
+		return (NULL);
+	if (((mlx_ctx_t*)mlx->context)->software)
+		return (image);
+
+	mlx_acquire_context(mlx->context);
+	const bool attached = mlx_attach_stream(image);
+	mlx_release_context(mlx->context);
+	if (!attached)
+		return (mlx_delete_image(mlx, image), NULL);
+	return (image);
+}
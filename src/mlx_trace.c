@@ -0,0 +1,158 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_trace.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:52:18 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:25:08 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+#include <stdatomic.h>
+
+static_assert((MLX_TRACE_SIZE & (MLX_TRACE_SIZE - 1)) == 0, "MLX_TRACE_SIZE must be a power of two");
+
+//= Private =//
+
+// A single complete span of the trace.
+typedef struct mlx_event
+{
+	const char*	name;
+	const void*	id;
+	double		start;
+	double		duration;
+	uint64_t	value;
+	uint32_t	thread;
+}	mlx_event_t;
+
+// Threads are numbered in the order they first record an event.
+static atomic_uint mlx_trace_threads = 0;
+static _Thread_local uint32_t mlx_trace_thread = 0;
+
+/**
+ * The trace is a ring of events, claiming a slot is a single atomic add
+ * so recording never takes a lock. Once full the oldest events are
+ * overwritten, which keeps the frames leading up to a hitch around.
+ */
+struct mlx_trace
+{
+	FILE*			file;
+	double			origin;
+	atomic_size_t	head;
+	mlx_event_t		events[MLX_TRACE_SIZE];
+};
+
+// Writes a string as a JSON string, names are supplied by the user.
+static void mlx_trace_string(FILE* file, const char* str)
+{
+	fputc('"', file);
+	for (; *str; str++)
+	{
+		if (*str == '"' || *str == '\\')
+			fputc('\\', file);
+		if ((unsigned char)*str >= ' ')
+			fputc(*str, file);
+	}
+	fputc('"', file);
+}
+
+static void mlx_trace_event(FILE* file, const mlx_trace_t* trace, const mlx_event_t* event)
+{
+	fputs("{\"name\":", file);
+	if (event->name)
+		mlx_trace_string(file, event->name);
+	else
+		fprintf(file, "\"hook %p\"", event->id);
+
+	// Timestamps are in microseconds.
+	fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f", \
+		event->thread, (event->start - trace->origin) * 1e6, event->duration * 1e6);
+	fprintf(file, ",\"args\":{\"id\":\"%p\",\"value\":%llu}}", event->id, (unsigned long long)event->value);
+}
+
+//= Public =//
+
+/**
+ * Starts a span of the trace.
+ * 
+ * @returns The start of the span, or 0 if no trace is being recorded.
+ */
+double mlx_trace_begin(const mlx_ctx_t* mlx)
+{
+	return (mlx->trace ? glfwGetTime() : 0);
+}
+
+/**
+ * Ends a span of the trace and records it.
+ * 
+ * @param mlx The MLX instance context.
+ * @param name The name of the span, it has to outlive the trace.
+ * @param id What the span is about, such as an image or a hook.
+ * @param start The start of the span, see mlx_trace_begin.
+ * @param value An extra value for the span, such as the amount of bytes.
+ */
+void mlx_trace_end(mlx_ctx_t* mlx, const char* name, const void* id, double start, uint64_t value)
+{
+	mlx_trace_t* const trace = mlx->trace;
+	if (!trace)
+		return;
+
+	// Spans of different threads overlap, so each gets a track of its own.
+	if (!mlx_trace_thread)
+		mlx_trace_thread = atomic_fetch_add_explicit(&mlx_trace_threads, 1, memory_order_relaxed) + 1;
+
+	const size_t slot = atomic_fetch_add_explicit(&trace->head, 1, memory_order_relaxed);
+	trace->events[slot & (MLX_TRACE_SIZE - 1)] = (mlx_event_t){
+		name, id, start, glfwGetTime() - start, value, mlx_trace_thread
+	};
+}
+
+/**
+ * Writes out the recorded events and ends the trace, oldest events first.
+ */
+void mlx_write_trace(mlx_ctx_t* mlx)
+{
+	mlx_trace_t* const trace = mlx->trace;
+	if (!trace)
+		return;
+
+	const size_t head = atomic_load(&trace->head);
+	const size_t first = head > MLX_TRACE_SIZE ? head - MLX_TRACE_SIZE : 0;
+
+	fputs("{\"traceEvents\":[\n", trace->file);
+	for (size_t i = first; i < head; i++)
+	{
+		mlx_trace_event(trace->file, trace, &trace->events[i & (MLX_TRACE_SIZE - 1)]);
+		fputs(i + 1 < head ? ",\n" : "\n", trace->file);
+	}
+	fputs("],\"displayTimeUnit\":\"ms\"}\n", trace->file);
+	fclose(trace->file);
+	free(trace);
+	mlx->trace = NULL;
+}
+
+bool mlx_start_trace(mlx_t* mlx, const char* path)
+{
+	MLX_NONNULL(mlx);
+	MLX_NONNULL(path);
+
+	mlx_ctx_t* const mlxctx = mlx->context;
+	if (mlxctx->trace)
+		return (true);
+
+	mlx_trace_t* trace;
+	if (!(trace = malloc(sizeof(mlx_trace_t))))
+		return (mlx_error(MLX_MEMFAIL));
+	if (!(trace->file = fopen(path, "w")))
+	{
+		free(trace);
+		return (mlx_error(MLX_INVFILE));
+	}
+	trace->origin = glfwGetTime();
+	atomic_init(&trace->head, 0);
+	mlxctx->trace = trace;
+	return (true);
+}
@@ -0,0 +1,231 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_transform.c                                    :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:10:53 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 07:10:53 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+#include <math.h>
+
+//= Private =//
+
+/**
+ * A transformed blit, drawn row by row. Every pixel of the destination
+ * within the bounds of the transformed source is mapped back onto the
+ * source by the inverse transformation:
+ *
+ * u = iu + ia * x + ib * y
+ * v = iv + ic * x + id * y
+ */
+typedef struct mlx_transform_job
+{
+	mlx_image_t*	dst;
+	const uint8_t*	pixels;
+	uint32_t		width;
+	uint32_t		height;
+	double			ia;
+	double			ib;
+	double			ic;
+	double			id;
+	double			iu;
+	double			iv;
+	int32_t			x0;
+	int32_t			y0;
+	int32_t			x1;
+	int32_t			y1;
+	mlx_filter_t	filter;
+	mlx_blend_t		mode;
+}	mlx_transform_job_t;
+
+static bool mlx_span_inside(const mlx_span_t* span, int64_t i)
+{
+	const int64_t u = span->u + span->du * i;
+	const int64_t v = span->v + span->dv * i;
+
+	return (u >= 0 && v >= 0 && u < (int64_t)span->width << 16 && v < (int64_t)span->height << 16);
+}
+
+// Narrows a range of samples down to those where 0 <= p + dp * i < size.
+static void mlx_clip_axis(int64_t p, int64_t dp, int64_t size, double* first, double* last)
+{
+	if (dp == 0)
+	{
+		if (p < 0 || p >= size)
+			*last = -1;
+		return;
+	}
+
+	const double a = (double)-p / dp;
+	const double b = (double)(size - p) / dp;
+	*first = fmax(*first, fmin(a, b));
+	*last = fmin(*last, fmax(a, b));
+}
+
+/**
+ * Finds the samples of a row that are within the source. Along a row
+ * those are always a single run, which is estimated and then corrected
+ * for the rounding of the fixed point steps.
+ */
+static void mlx_clip_span(const mlx_span_t* span, int64_t count, int64_t* lo, int64_t* hi)
+{
+	double first = 0;
+	double last = count;
+
+	mlx_clip_axis(span->u, span->du, (int64_t)span->width << 16, &first, &last);
+	mlx_clip_axis(span->v, span->dv, (int64_t)span->height << 16, &first, &last);
+	*lo = first > 1 ? (int64_t)first - 1 : 0;
+	*hi = last + 2 < count ? (int64_t)last + 2 : count;
+	while (*lo < *hi && !mlx_span_inside(span, *lo))
+		(*lo)++;
+	while (*hi > *lo && !mlx_span_inside(span, *hi - 1))
+		(*hi)--;
+}
+
+static void mlx_sample_nearest(uint8_t* dst, const mlx_span_t* span, size_t count)
+{
+	int64_t u = span->u;
+	int64_t v = span->v;
+
+	for (size_t i = 0; i < count; i++, dst += BPP, u += span->du, v += span->dv)
+		memcpy(dst, &span->pixels[((v >> 16) * span->width + (u >> 16)) * BPP], BPP);
+}
+
+/**
+ * Draws a row of the destination, sampling a handful of pixels at a
+ * time before blending them on, so they stay in the cache.
+ */
+static void mlx_transform_row(const mlx_transform_job_t* job, int32_t y)
+{
+	const double cx = job->x0 + 0.5;
+	const double cy = y + 0.5;
+	mlx_span_t span = {
+		job->pixels, job->width, job->height,
+		llround((job->iu + job->ia * cx + job->ib * cy) * 65536.0),
+		llround((job->iv + job->ic * cx + job->id * cy) * 65536.0),
+		llround(job->ia * 65536.0),
+		llround(job->ic * 65536.0),
+	};
+
+	int64_t lo, hi;
+	mlx_clip_span(&span, job->x1 - job->x0, &lo, &hi);
+	span.u += span.du * lo;
+	span.v += span.dv * lo;
+
+	uint8_t samples[MLX_SPAN_SIZE * BPP];
+	uint8_t* row = &job->dst->pixels[((size_t)y * job->dst->width + job->x0 + lo) * BPP];
+	for (int64_t x = lo; x < hi; x += MLX_SPAN_SIZE, row += MLX_SPAN_SIZE * BPP)
+	{
+		const size_t count = hi - x < MLX_SPAN_SIZE ? hi - x : MLX_SPAN_SIZE;
+
+		if (job->filter == MLX_FILTER_BILINEAR)
+			mlx_kernels.bilinear(samples, &span, count);
+		else
+			mlx_sample_nearest(samples, &span, count);
+		mlx_kernels.blit(row, samples, count, job->mode);
+		span.u += span.du * count;
+		span.v += span.dv * count;
+	}
+}
+
+static void mlx_transform_tile(void* param, uint32_t index)
+{
+	const mlx_transform_job_t* job = param;
+	const int32_t top = job->y0 + index * MLX_TILE_SIZE;
+	const int32_t bottom = top + MLX_TILE_SIZE < job->y1 ? top + MLX_TILE_SIZE : job->y1;
+
+	for (int32_t y = top; y < bottom; y++)
+		mlx_transform_row(job, y);
+}
+
+/**
+ * Sets up the inverse transformation and the part of the destination
+ * covered by the source, false if nothing is left to draw.
+ */
+static bool mlx_setup_transform(mlx_transform_job_t* job, const mlx_transform_t* t)
+{
+	const double det = (double)t->a * t->d - (double)t->b * t->c;
+	if (!isfinite(det) || fabs(det) < 1e-12)
+		return (false);
+
+	job->ia = t->d / det;
+	job->ib = -t->b / det;
+	job->ic = -t->c / det;
+	job->id = t->a / det;
+	job->iu = -(job->ia * t->tx + job->ib * t->ty);
+	job->iv = -(job->ic * t->tx + job->id * t->ty);
+
+	double min_x = INFINITY, min_y = INFINITY, max_x = -INFINITY, max_y = -INFINITY;
+	for (int32_t i = 0; i < 4; i++)
+	{
+		const double x = i & 1 ? job->width : 0;
+		const double y = i & 2 ? job->height : 0;
+		const double px = t->a * x + t->b * y + t->tx;
+		const double py = t->c * x + t->d * y + t->ty;
+
+		min_x = fmin(min_x, px);
+		min_y = fmin(min_y, py);
+		max_x = fmax(max_x, px);
+		max_y = fmax(max_y, py);
+	}
+	if (!isfinite(min_x + min_y + max_x + max_y))
+		return (false);
+
+	job->x0 = fmin(fmax(floor(min_x), 0), job->dst->width);
+	job->y0 = fmin(fmax(floor(min_y), 0), job->dst->height);
+	job->x1 = fmax(fmin(ceil(max_x), job->dst->width), job->x0);
+	job->y1 = fmax(fmin(ceil(max_y), job->dst->height), job->y0);
+
+	// Shrunk so far that stepping through a row in fixed point would overflow.
+	const double limit = (double)((int64_t)1 << 46) / ((double)job->x1 - job->x0 + job->width + job->height + 2);
+	if (fmax(fmax(fabs(job->ia), fabs(job->ib)), fmax(fabs(job->ic), fabs(job->id))) > limit)
+		return (false);
+	return (job->x0 < job->x1 && job->y0 < job->y1);
+}
+
+static void mlx_blit_transformed(mlx_t* mlx, mlx_transform_job_t* job, const mlx_transform_t* transform)
+{
+	MLX_NONNULL(transform);
+	MLX_ASSERT(job->filter < MLX_FILTER_MAX, "Invalid filter");
+	MLX_ASSERT(job->mode < MLX_BLEND_MAX, "Invalid blend mode");
+	MLX_ASSERT(job->pixels != job->dst->pixels, "Can't blit an image onto itself");
+
+	if (job->width == 0 || job->height == 0 || !mlx_setup_transform(job, transform))
+		return;
+
+	const uint32_t tiles = (job->y1 - job->y0 + MLX_TILE_SIZE - 1) / MLX_TILE_SIZE;
+	mlx_pool_t* pool = mlx ? mlx_get_pool(mlx->context) : NULL;
+	if (pool && tiles > 1)
+		mlx_pool_run(pool, mlx_transform_tile, job, tiles);
+	else
+	{
+		for (uint32_t i = 0; i < tiles; i++)
+			mlx_transform_tile(job, i);
+	}
+	mlx_image_mark_dirty(job->dst, job->x0, job->y0, job->x1 - job->x0, job->y1 - job->y0);
+}
+
+//= Public =//
+
+void mlx_blit_image_transformed(mlx_t* mlx, mlx_image_t* dst, const mlx_image_t* src, const mlx_transform_t* transform, mlx_filter_t filter, mlx_blend_t mode)
+{
+	MLX_NONNULL(dst);
+	MLX_NONNULL(src);
+
+	mlx_transform_job_t job = {.dst = dst, .pixels = src->pixels, .width = src->width, .height = src->height, .filter = filter, .mode = mode};
+	mlx_blit_transformed(mlx, &job, transform);
+}
+
+void mlx_blit_texture_transformed(mlx_t* mlx, mlx_image_t* image, const mlx_texture_t* texture, const mlx_transform_t* transform, mlx_filter_t filter, mlx_blend_t mode)
+{
+	MLX_NONNULL(image);
+	MLX_NONNULL(texture);
+
+	mlx_transform_job_t job = {.dst = image, .pixels = texture->pixels, .width = texture->width, .height = texture->height, .filter = filter, .mode = mode};
+	mlx_blit_transformed(mlx, &job, transform);
+}
@@ -6,7 +6,7 @@
 /*   By: W2wizard <w2wizzard@gmail.com>               +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2022/02/08 01:14:59 by W2wizard      #+#    #+#                 */
-/*   Updated: 2022/11/22 09:06:54 by jvan-hal      ########   odam.nl         */
+/*   Updated: 2026/10/18 08:02:17 by W2Wizard      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -18,17 +18,19 @@
  * Recalculate the view projection matrix, used by images for screen pos
  * Reference: https://bit.ly/3KuHOu1 (Matrix View Projection)
  */
-void mlx_update_matrix(const mlx_t* mlx, int32_t width, int32_t height)
+void mlx_update_matrix(const mlx_t* mlx, int32_t width, int32_t height, int32_t zdepth)
 {
-	const mlx_ctx_t* mlxctx = mlx->context;
-	const float depth = mlxctx->zdepth;
+	mlx_ctx_t* mlxctx = mlx->context;
+	const float depth = zdepth;
 
 	/**
 	 * In case the setting to stretch the image is set, we maintain the width and height but not
 	 * the depth.
 	 */
-	width = mlx_settings[MLX_STRETCH_IMAGE] ? mlxctx->initialWidth : mlx->width;
-	height = mlx_settings[MLX_STRETCH_IMAGE] ? mlxctx->initialHeight : mlx->height;
+	width = mlx_settings[MLX_STRETCH_IMAGE] ? mlxctx->initialWidth : width;
+	height = mlx_settings[MLX_STRETCH_IMAGE] ? mlxctx->initialHeight : height;
+	mlxctx->viewWidth = width;
+	mlxctx->viewHeight = height;
 
 	const float matrix[16] = {
 		2.f / width, 0, 0, 0,
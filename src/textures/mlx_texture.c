@@ -6,7 +6,7 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2022/02/17 01:02:24 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/06/29 15:34:25 by lde-la-h      ########   odam.nl         */
+/*   Updated: 2026/10/18 06:27:26 by W2Wizard      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -73,6 +73,7 @@ bool mlx_draw_texture(mlx_image_t* image, mlx_texture_t* texture, uint32_t x, ui
 		pixeli = &image->pixels[((i + y) * image->width + x) * texture->bytes_per_pixel];
 		memmove(pixeli, pixelx, texture->width * texture->bytes_per_pixel);
 	}
+	mlx_image_mark_dirty(image, x, y, texture->width, texture->height);
 	return (true);
 }
 
@@ -6,7 +6,7 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2021/12/28 01:53:51 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/11/26 14:26:23 by jvan-hal      ########   odam.nl         */
+/*   Updated: 2026/10/18 06:41:32 by W2Wizard      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -101,12 +101,12 @@ bool mlx_equal_image(void* lstcontent, void* value)
 	return (lcontent == lvalue);
 }
 
-bool mlx_equal_inst(void* lstcontent, void* value)
+bool mlx_equal_atlas(void* lstcontent, void* value)
 {
-	const draw_queue_t* lcontent = lstcontent;
-	const mlx_image_t* lvalue = value;
+	const mlx_atlas_t* lcontent = lstcontent;
+	const mlx_atlas_t* lvalue = value;
 
-	return (lcontent->image == lvalue);
+	return (lcontent == lvalue);
 }
 
 /**
@@ -133,64 +133,3 @@ mlx_list_t* mlx_lstremove(mlx_list_t** lst, void* value, bool (*comp)(void*, voi
 		lstcpy->prev->next = lstcpy->next;
 	return (lstcpy);
 }
-
-// Retrieve Z value from queue.
-static int32_t mlx_getzdata(mlx_list_t* entry)
-{
-	const draw_queue_t* queue = entry->content;
-
-	return (queue->image->instances[queue->instanceid].z);
-}
-
-// Insert the entry back into head sorted.
-static void mlx_insertsort(mlx_list_t** head, mlx_list_t* new)
-{
-	mlx_list_t* current;
-
-	if (*head == NULL)
-		*head = new;
-	else if (mlx_getzdata(*head) >= mlx_getzdata(new))
-	{
-		new->next = *head;
-		new->next->prev = new;
-		*head = new;
-	}
-	else
-	{
-		current = *head;
-
-		// Find insertion location.
-		while (current->next != NULL && mlx_getzdata(current->next) < mlx_getzdata(new))
-			current = current->next;
-		new->next = current->next;
-
-		// Insert at the end
-		if (current->next != NULL)
-			new->next->prev = new;
-		current->next = new;
-		new->prev = current;
-	}
-}
-
-/**
- * Okay-ish sorting algorithm to sort the render queue / doubly linked list.
- * We need to do this to fix transparency.
- *
- * @param lst The render queue.
- */
-void mlx_sort_renderqueue(mlx_list_t** lst)
-{
-	mlx_list_t* sorted = NULL;
-	mlx_list_t* lstcpy = *lst;
-
-	while (lstcpy != NULL)
-	{
-		mlx_list_t* next = lstcpy->next;
-
-		// Separate entry out of list and insert it back but sorted.
-		lstcpy->prev = lstcpy->next = NULL;
-		mlx_insertsort(&sorted, lstcpy);
-		lstcpy = next;
-	}
-	*lst = sorted;
-}
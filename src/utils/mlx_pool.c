@@ -0,0 +1,269 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_pool.c                                         :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:57:39 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 07:21:57 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#ifndef _WIN32
+# include <unistd.h>
+#endif
+
+//= Private =//
+
+/**
+ * A thread of the pool, together with the range of tasks it has left
+ * packed as begin << 32 | end. The thread takes tasks from the front,
+ * others that ran out of work steal them from the back.
+ * 
+ * Padded so threads don't fight over the same cache line.
+ */
+typedef struct mlx_worker
+{
+	pthread_t			thread;
+	mlx_pool_t*			pool;
+	_Atomic(uint64_t)	range;
+	uint8_t				padding[64];
+}	mlx_worker_t;
+
+/**
+ * A fixed set of worker threads that run the tasks of a job together
+ * with the thread that handed out the job. Every thread starts out with
+ * an even share of the tasks, neighbouring tasks stay on the same thread
+ * and threads that finish early steal half of what another has left.
+ * 
+ * The first worker is the thread that runs the job.
+ */
+struct mlx_pool
+{
+	mlx_worker_t*	workers;
+	uint32_t		count;
+	pthread_mutex_t	lock;
+	pthread_cond_t	wake;
+	pthread_cond_t	done;
+	uint64_t		job;
+	uint32_t		busy;
+	bool			quit;
+	mlx_task_t		task;
+	void*			param;
+};
+
+// The pool the current thread is running tasks of, if any.
+static _Thread_local mlx_pool_t* mlx_running_pool = NULL;
+
+static bool mlx_pop_task(mlx_worker_t* worker, uint32_t* index)
+{
+	uint64_t range = atomic_load(&worker->range);
+
+	while ((uint32_t)(range >> 32) < (uint32_t)range)
+	{
+		if (atomic_compare_exchange_weak(&worker->range, &range, range + ((uint64_t)1 << 32)))
+		{
+			*index = range >> 32;
+			return (true);
+		}
+	}
+	return (false);
+}
+
+static bool mlx_steal_tasks(mlx_pool_t* pool, mlx_worker_t* thief)
+{
+	const uint32_t threads = pool->count + 1;
+	const uint32_t self = thief - pool->workers;
+
+	for (uint32_t i = 1; i < threads; i++)
+	{
+		mlx_worker_t* victim = &pool->workers[(self + i) % threads];
+		uint64_t range = atomic_load(&victim->range);
+
+		while ((uint32_t)(range >> 32) < (uint32_t)range)
+		{
+			const uint32_t begin = range >> 32;
+			const uint32_t end = range;
+			const uint32_t half = begin + (end - begin) / 2;
+
+			if (atomic_compare_exchange_weak(&victim->range, &range, (uint64_t)begin << 32 | half))
+			{
+				atomic_store(&thief->range, (uint64_t)half << 32 | end);
+				return (true);
+			}
+		}
+	}
+	return (false);
+}
+
+static void mlx_pool_work(mlx_pool_t* pool, mlx_worker_t* worker)
+{
+	uint32_t index;
+
+	do
+	{
+		while (mlx_pop_task(worker, &index))
+			pool->task(pool->param, index);
+	}
+	while (mlx_steal_tasks(pool, worker));
+}
+
+static void* mlx_pool_worker(void* param)
+{
+	mlx_worker_t* const worker = param;
+	mlx_pool_t* const pool = worker->pool;
+	uint64_t job = 0;
+
+	mlx_running_pool = pool;
+	pthread_mutex_lock(&pool->lock);
+	while (true)
+	{
+		while (!pool->quit && pool->job == job)
+			pthread_cond_wait(&pool->wake, &pool->lock);
+		if (pool->quit)
+			break;
+		job = pool->job;
+		pthread_mutex_unlock(&pool->lock);
+
+		mlx_pool_work(pool, worker);
+
+		pthread_mutex_lock(&pool->lock);
+		if (--pool->busy == 0)
+			pthread_cond_signal(&pool->done);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return (NULL);
+}
+
+//= Public =//
+
+/**
+ * Returns the amount of threads the machine can run at once.
+ */
+uint32_t mlx_cpu_count(void)
+{
+#ifdef _SC_NPROCESSORS_ONLN
+	const long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return (count > 0 ? count : 1);
+#else
+	return (4);
+#endif
+}
+
+/**
+ * Returns the amount of threads to render with, as set by MLX_THREADS.
+ */
+uint32_t mlx_thread_count(void)
+{
+	const int32_t threads = mlx_settings[MLX_THREADS];
+
+	return (threads > 0 ? (uint32_t)threads : mlx_cpu_count());
+}
+
+/**
+ * Returns the pool shared by everything that runs in parallel, such as
+ * the software backend, created the first time it's needed.
+ */
+mlx_pool_t* mlx_get_pool(mlx_ctx_t* mlx)
+{
+	if (!mlx->pool)
+		mlx->pool = mlx_new_pool(mlx_thread_count());
+	return (mlx->pool);
+}
+
+/**
+ * Creates a pool with the given amount of threads, including the
+ * thread that runs the jobs, so one thread means no workers at all.
+ */
+mlx_pool_t* mlx_new_pool(uint32_t threads)
+{
+	mlx_pool_t* pool;
+	if (!(pool = calloc(1, sizeof(mlx_pool_t))))
+		return ((void*)mlx_error(MLX_MEMFAIL));
+	if (!(pool->workers = calloc(threads > 1 ? threads : 1, sizeof(mlx_worker_t))))
+		return (free(pool), (void*)mlx_error(MLX_MEMFAIL));
+
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->wake, NULL);
+	pthread_cond_init(&pool->done, NULL);
+
+	// Running with fewer workers than asked for still works, just slower.
+	for (uint32_t i = 1; i < threads; i++)
+	{
+		mlx_worker_t* const worker = &pool->workers[i];
+
+		worker->pool = pool;
+		atomic_init(&worker->range, 0);
+		if (pthread_create(&worker->thread, NULL, mlx_pool_worker, worker) != 0)
+			break;
+		pool->count++;
+	}
+	pool->workers[0].pool = pool;
+	atomic_init(&pool->workers[0].range, 0);
+	return (pool);
+}
+
+/**
+ * Runs a task for every index up to count and waits until all are done.
+ * Running a job from within a task runs it on the calling thread alone.
+ * 
+ * @param pool The pool to run the tasks on.
+ * @param task The task, called with the parameter and the task index.
+ * @param param The parameter to pass onto the task.
+ * @param count The amount of tasks.
+ */
+void mlx_pool_run(mlx_pool_t* pool, mlx_task_t task, void* param, uint32_t count)
+{
+	if (mlx_running_pool == pool || pool->count == 0)
+	{
+		for (uint32_t i = 0; i < count; i++)
+			task(param, i);
+		return;
+	}
+
+	const uint32_t threads = pool->count + 1;
+	pthread_mutex_lock(&pool->lock);
+	pool->task = task;
+	pool->param = param;
+	for (uint32_t i = 0; i < threads; i++)
+	{
+		const uint64_t begin = (uint64_t)count * i / threads;
+		const uint64_t end = (uint64_t)count * (i + 1) / threads;
+		atomic_store(&pool->workers[i].range, begin << 32 | end);
+	}
+	pool->busy = pool->count;
+	pool->job++;
+	pthread_cond_broadcast(&pool->wake);
+	pthread_mutex_unlock(&pool->lock);
+
+	mlx_running_pool = pool;
+	mlx_pool_work(pool, &pool->workers[0]);
+	mlx_running_pool = NULL;
+
+	pthread_mutex_lock(&pool->lock);
+	while (pool->busy > 0)
+		pthread_cond_wait(&pool->done, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+}
+
+void mlx_delete_pool(mlx_pool_t* pool)
+{
+	if (!pool)
+		return;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->quit = true;
+	pthread_cond_broadcast(&pool->wake);
+	pthread_mutex_unlock(&pool->lock);
+	for (uint32_t i = 1; i <= pool->count; i++)
+		pthread_join(pool->workers[i].thread, NULL);
+
+	pthread_mutex_destroy(&pool->lock);
+	pthread_cond_destroy(&pool->wake);
+	pthread_cond_destroy(&pool->done);
+	mlx_freen(2, pool->workers, pool);
+}
@@ -0,0 +1,152 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_queue.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:18:27 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 07:18:27 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+#include <stdatomic.h>
+
+//= Private =//
+
+/**
+ * A bounded queue that any amount of threads can push onto and pop from
+ * at the same time without locks.
+ * 
+ * Every cell carries a sequence number telling whose turn it is: a cell
+ * at position p is free to push onto once its sequence is p, and holds
+ * an item ready to pop once it's p + 1. Popping sets it to p + capacity,
+ * handing the cell over to the push one lap later.
+ * 
+ * Both ends are padded onto cache lines of their own so pushing and
+ * popping threads don't fight over them.
+ */
+struct mlx_queue
+{
+	_Atomic(size_t)	head;
+	uint8_t			head_padding[64];
+	_Atomic(size_t)	tail;
+	uint8_t			tail_padding[64];
+	uint8_t*		cells;
+	size_t			stride;
+	size_t			size;
+	size_t			mask;
+};
+
+// The sequence of a cell, followed by the item.
+typedef struct mlx_cell
+{
+	_Atomic(size_t)	sequence;
+}	mlx_cell_t;
+
+#define MLX_CELL_ALIGN 8
+
+static mlx_cell_t* mlx_queue_cell(const mlx_queue_t* queue, size_t position)
+{
+	return ((mlx_cell_t*)&queue->cells[(position & queue->mask) * queue->stride]);
+}
+
+//= Public =//
+
+/**
+ * Creates a queue of items of the given size.
+ * 
+ * @param capacity The least amount of items the queue can hold.
+ * @param size The size of an item in bytes.
+ * @return The queue or NULL on failure.
+ */
+mlx_queue_t* mlx_new_queue(size_t capacity, size_t size)
+{
+	size_t count = 2;
+	while (count < capacity)
+		count *= 2;
+
+	mlx_queue_t* queue;
+	if (!(queue = calloc(1, sizeof(mlx_queue_t))))
+		return ((void*)mlx_error(MLX_MEMFAIL));
+	queue->size = size;
+	queue->mask = count - 1;
+	queue->stride = (sizeof(mlx_cell_t) + size + MLX_CELL_ALIGN - 1) & ~(size_t)(MLX_CELL_ALIGN - 1);
+	if (!(queue->cells = malloc(count * queue->stride)))
+		return (free(queue), (void*)mlx_error(MLX_MEMFAIL));
+
+	for (size_t i = 0; i < count; i++)
+		atomic_init(&mlx_queue_cell(queue, i)->sequence, i);
+	atomic_init(&queue->head, 0);
+	atomic_init(&queue->tail, 0);
+	return (queue);
+}
+
+/**
+ * Copies an item onto the back of the queue.
+ * 
+ * @return False if the queue is full.
+ */
+bool mlx_queue_push(mlx_queue_t* queue, const void* item)
+{
+	size_t position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+	mlx_cell_t* cell;
+
+	while (true)
+	{
+		cell = mlx_queue_cell(queue, position);
+		const size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+		const intptr_t diff = (intptr_t)(sequence - position);
+
+		if (diff == 0)
+		{
+			if (atomic_compare_exchange_weak_explicit(&queue->head, &position, position + 1, memory_order_relaxed, memory_order_relaxed))
+				break;
+		}
+		else if (diff < 0)
+			return (false);
+		else
+			position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+	}
+	memcpy(cell + 1, item, queue->size);
+	atomic_store_explicit(&cell->sequence, position + 1, memory_order_release);
+	return (true);
+}
+
+/**
+ * Copies the item at the front of the queue out and removes it.
+ * 
+ * @return False if the queue is empty.
+ */
+bool mlx_queue_pop(mlx_queue_t* queue, void* item)
+{
+	size_t position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+	mlx_cell_t* cell;
+
+	while (true)
+	{
+		cell = mlx_queue_cell(queue, position);
+		const size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+		const intptr_t diff = (intptr_t)(sequence - (position + 1));
+
+		if (diff == 0)
+		{
+			if (atomic_compare_exchange_weak_explicit(&queue->tail, &position, position + 1, memory_order_relaxed, memory_order_relaxed))
+				break;
+		}
+		else if (diff < 0)
+			return (false);
+		else
+			position = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+	}
+	memcpy(item, cell + 1, queue->size);
+	atomic_store_explicit(&cell->sequence, position + queue->mask + 1, memory_order_release);
+	return (true);
+}
+
+void mlx_delete_queue(mlx_queue_t* queue)
+{
+	if (queue)
+		mlx_freen(2, queue->cells, queue);
+}
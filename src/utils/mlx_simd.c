@@ -0,0 +1,428 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_simd.c                                         :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:01:26 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 07:13:30 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+#if defined(__x86_64__) || defined(__i386__)
+# include <immintrin.h>
+# define MLX_X86
+#elif defined(__aarch64__)
+# include <arm_neon.h>
+#endif
+
+//= Private =//
+
+/**
+ * Pixel kernels for bulk operations on rows of RGBA pixels.
+ * 
+ * The x86 kernels are compiled for their instruction set regardless of
+ * the flags of the build, mlx_init_kernels picks the best one the CPU
+ * running it supports. NEON is always available on 64 bit ARM.
+ * 
+ * All of them blend exactly the same, down to the rounding, each channel
+ * is computed as listed in mlx_blit_channel.
+ */
+
+static void mlx_fill_scalar(uint8_t* dst, uint32_t pixel, size_t count)
+{
+	uint32_t* row = (uint32_t*)dst;
+
+	for (size_t i = 0; i < count; i++)
+		row[i] = pixel;
+}
+
+// Divides by 255 and rounds to the nearest value, for values up to 255 * 255.
+static uint32_t mlx_div255(uint32_t value)
+{
+	value += 128;
+	return ((value + (value >> 8)) >> 8);
+}
+
+static uint8_t mlx_blit_channel(uint32_t src, uint32_t dst, uint32_t alpha, bool is_alpha, mlx_blend_t mode)
+{
+	uint32_t value;
+
+	switch (mode)
+	{
+		case MLX_BLEND_PREMULTIPLIED:
+			value = src + mlx_div255(dst * (255 - alpha));
+			break;
+		case MLX_BLEND_ADD:
+			value = dst + mlx_div255(src * alpha);
+			break;
+		case MLX_BLEND_MULTIPLY:
+			value = is_alpha ? dst : mlx_div255(dst * mlx_div255(src * alpha + 255 * (255 - alpha)));
+			break;
+		default: // Same as the blending of the OpenGL backend.
+			value = mlx_div255(src * alpha + dst * (255 - alpha));
+			break;
+	}
+	return (value > 255 ? 255 : value);
+}
+
+static void mlx_blit_scalar(uint8_t* dst, const uint8_t* src, size_t count, mlx_blend_t mode)
+{
+	const bool copy = mode == MLX_BLEND_ALPHA || mode == MLX_BLEND_PREMULTIPLIED;
+
+	for (size_t i = 0; i < count; i++, dst += BPP, src += BPP)
+	{
+		const uint8_t alpha = src[3];
+
+		if (alpha == 0xFF && copy)
+			memcpy(dst, src, BPP);
+		else if (alpha != 0 || mode == MLX_BLEND_PREMULTIPLIED)
+		{
+			for (uint32_t c = 0; c < BPP; c++)
+				dst[c] = mlx_blit_channel(src[c], dst[c], alpha, c == 3, mode);
+		}
+	}
+}
+
+/**
+ * The four pixels around a sample and the weights of the right and
+ * bottom ones, in 8 bits. Pixels beyond the edges repeat the edge.
+ */
+static void mlx_bilinear_taps(const mlx_span_t* span, int64_t u, int64_t v, const uint8_t* taps[4], uint32_t weights[2])
+{
+	// Sample between the pixel centers.
+	u -= 0x8000;
+	v -= 0x8000;
+
+	const int64_t x = u >> 16;
+	const int64_t y = v >> 16;
+	const int64_t x0 = x < 0 ? 0 : x;
+	const int64_t y0 = y < 0 ? 0 : y;
+	const int64_t x1 = x + 1 < span->width ? x + 1 : span->width - 1;
+	const int64_t y1 = y + 1 < span->height ? y + 1 : span->height - 1;
+
+	const uint8_t* top = &span->pixels[y0 * span->width * BPP];
+	const uint8_t* bottom = &span->pixels[y1 * span->width * BPP];
+	taps[0] = &top[x0 * BPP];
+	taps[1] = &top[x1 * BPP];
+	taps[2] = &bottom[x0 * BPP];
+	taps[3] = &bottom[x1 * BPP];
+	weights[0] = (u >> 8) & 0xFF;
+	weights[1] = (v >> 8) & 0xFF;
+}
+
+static uint32_t mlx_lerp(uint32_t a, uint32_t b, uint32_t weight)
+{
+	return ((a * (256 - weight) + b * weight + 128) >> 8);
+}
+
+static void mlx_bilinear_scalar(uint8_t* dst, const mlx_span_t* span, size_t count)
+{
+	int64_t u = span->u;
+	int64_t v = span->v;
+
+	for (size_t i = 0; i < count; i++, dst += BPP, u += span->du, v += span->dv)
+	{
+		const uint8_t* taps[4];
+		uint32_t weights[2];
+
+		mlx_bilinear_taps(span, u, v, taps, weights);
+		for (uint32_t c = 0; c < BPP; c++)
+		{
+			const uint32_t top = mlx_lerp(taps[0][c], taps[1][c], weights[0]);
+			const uint32_t bottom = mlx_lerp(taps[2][c], taps[3][c], weights[0]);
+			dst[c] = mlx_lerp(top, bottom, weights[1]);
+		}
+	}
+}
+
+#ifdef MLX_X86
+__attribute__((target("sse2")))
+static void mlx_fill_sse2(uint8_t* dst, uint32_t pixel, size_t count)
+{
+	const __m128i pixels = _mm_set1_epi32((int32_t)pixel);
+	size_t i = 0;
+
+	for (; i + 4 <= count; i += 4)
+		_mm_storeu_si128((__m128i*)&dst[i * BPP], pixels);
+	mlx_fill_scalar(&dst[i * BPP], pixel, count - i);
+}
+
+__attribute__((target("sse2")))
+static __m128i mlx_div255_sse2(__m128i value)
+{
+	value = _mm_add_epi16(value, _mm_set1_epi16(128));
+	return (_mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8));
+}
+
+// Blends two pixels, widened to 16 bits per channel. Packing saturates what overflows.
+__attribute__((target("sse2")))
+static __m128i mlx_blit_wide_sse2(__m128i src, __m128i dst, mlx_blend_t mode)
+{
+	__m128i alpha = _mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3));
+	alpha = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+	const __m128i full = _mm_set1_epi16(255);
+	const __m128i inverse = _mm_sub_epi16(full, alpha);
+
+	switch (mode)
+	{
+		case MLX_BLEND_PREMULTIPLIED:
+			return (_mm_add_epi16(src, mlx_div255_sse2(_mm_mullo_epi16(dst, inverse))));
+		case MLX_BLEND_ADD:
+			return (_mm_add_epi16(dst, mlx_div255_sse2(_mm_mullo_epi16(src, alpha))));
+		case MLX_BLEND_MULTIPLY:
+		{
+			__m128i factor = _mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(full, inverse));
+			factor = _mm_or_si128(mlx_div255_sse2(factor), _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0));
+			return (mlx_div255_sse2(_mm_mullo_epi16(dst, factor)));
+		}
+		default:
+			return (mlx_div255_sse2(_mm_add_epi16(_mm_mullo_epi16(src, alpha), _mm_mullo_epi16(dst, inverse))));
+	}
+}
+
+/**
+ * Blends four pixels at a time, runs that are entirely opaque or
+ * transparent, which is most of them, are copied or skipped.
+ */
+__attribute__((target("sse2")))
+static void mlx_blit_sse2(uint8_t* dst, const uint8_t* src, size_t count, mlx_blend_t mode)
+{
+	const bool copy = mode == MLX_BLEND_ALPHA || mode == MLX_BLEND_PREMULTIPLIED;
+	const __m128i mask = _mm_set1_epi32((int32_t)0xFF000000);
+	const __m128i zero = _mm_setzero_si128();
+	size_t i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const __m128i pixels = _mm_loadu_si128((const __m128i*)&src[i * BPP]);
+		const __m128i alpha = _mm_and_si128(pixels, mask);
+
+		if (copy && _mm_movemask_epi8(_mm_cmpeq_epi8(alpha, mask)) == 0xFFFF)
+		{
+			_mm_storeu_si128((__m128i*)&dst[i * BPP], pixels);
+			continue;
+		}
+
+		// Premultiplied pixels may still add light without any alpha.
+		const __m128i empty = mode == MLX_BLEND_PREMULTIPLIED ? pixels : alpha;
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(empty, zero)) == 0xFFFF)
+			continue;
+
+		const __m128i back = _mm_loadu_si128((const __m128i*)&dst[i * BPP]);
+		const __m128i low = mlx_blit_wide_sse2(_mm_unpacklo_epi8(pixels, zero), _mm_unpacklo_epi8(back, zero), mode);
+		const __m128i high = mlx_blit_wide_sse2(_mm_unpackhi_epi8(pixels, zero), _mm_unpackhi_epi8(back, zero), mode);
+		_mm_storeu_si128((__m128i*)&dst[i * BPP], _mm_packus_epi16(low, high));
+	}
+	mlx_blit_scalar(&dst[i * BPP], &src[i * BPP], count - i, mode);
+}
+
+__attribute__((target("sse2")))
+static __m128i mlx_load_pixel_sse2(const uint8_t* pixel)
+{
+	int32_t value;
+
+	memcpy(&value, pixel, BPP);
+	return (_mm_cvtsi32_si128(value));
+}
+
+/**
+ * Interpolates both pairs of neighbours of a sample at once, side by
+ * side in a register, and then the resulting two pixels.
+ */
+__attribute__((target("sse2")))
+static void mlx_bilinear_sse2(uint8_t* dst, const mlx_span_t* span, size_t count)
+{
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i round = _mm_set1_epi16(128);
+	int64_t u = span->u;
+	int64_t v = span->v;
+
+	for (size_t i = 0; i < count; i++, dst += BPP, u += span->du, v += span->dv)
+	{
+		const uint8_t* taps[4];
+		uint32_t weights[2];
+
+		mlx_bilinear_taps(span, u, v, taps, weights);
+		const __m128i wx = _mm_unpacklo_epi64(_mm_set1_epi16(256 - weights[0]), _mm_set1_epi16(weights[0]));
+		const __m128i wy = _mm_unpacklo_epi64(_mm_set1_epi16(256 - weights[1]), _mm_set1_epi16(weights[1]));
+
+		__m128i top = _mm_unpacklo_epi32(mlx_load_pixel_sse2(taps[0]), mlx_load_pixel_sse2(taps[1]));
+		__m128i bottom = _mm_unpacklo_epi32(mlx_load_pixel_sse2(taps[2]), mlx_load_pixel_sse2(taps[3]));
+		top = _mm_mullo_epi16(_mm_unpacklo_epi8(top, zero), wx);
+		bottom = _mm_mullo_epi16(_mm_unpacklo_epi8(bottom, zero), wx);
+		top = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(top, _mm_srli_si128(top, 8)), round), 8);
+		bottom = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(bottom, _mm_srli_si128(bottom, 8)), round), 8);
+
+		__m128i pixel = _mm_mullo_epi16(_mm_unpacklo_epi64(top, bottom), wy);
+		pixel = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(pixel, _mm_srli_si128(pixel, 8)), round), 8);
+		const int32_t value = _mm_cvtsi128_si32(_mm_packus_epi16(pixel, zero));
+		memcpy(dst, &value, BPP);
+	}
+}
+
+__attribute__((target("avx2")))
+static void mlx_fill_avx2(uint8_t* dst, uint32_t pixel, size_t count)
+{
+	const __m256i pixels = _mm256_set1_epi32((int32_t)pixel);
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8)
+		_mm256_storeu_si256((__m256i*)&dst[i * BPP], pixels);
+	mlx_fill_scalar(&dst[i * BPP], pixel, count - i);
+}
+
+__attribute__((target("avx2")))
+static __m256i mlx_div255_avx2(__m256i value)
+{
+	value = _mm256_add_epi16(value, _mm256_set1_epi16(128));
+	return (_mm256_srli_epi16(_mm256_add_epi16(value, _mm256_srli_epi16(value, 8)), 8));
+}
+
+__attribute__((target("avx2")))
+static __m256i mlx_blit_wide_avx2(__m256i src, __m256i dst, mlx_blend_t mode)
+{
+	__m256i alpha = _mm256_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3));
+	alpha = _mm256_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+	const __m256i full = _mm256_set1_epi16(255);
+	const __m256i inverse = _mm256_sub_epi16(full, alpha);
+
+	switch (mode)
+	{
+		case MLX_BLEND_PREMULTIPLIED:
+			return (_mm256_add_epi16(src, mlx_div255_avx2(_mm256_mullo_epi16(dst, inverse))));
+		case MLX_BLEND_ADD:
+			return (_mm256_add_epi16(dst, mlx_div255_avx2(_mm256_mullo_epi16(src, alpha))));
+		case MLX_BLEND_MULTIPLY:
+		{
+			__m256i factor = _mm256_add_epi16(_mm256_mullo_epi16(src, alpha), _mm256_mullo_epi16(full, inverse));
+			factor = _mm256_or_si256(mlx_div255_avx2(factor), _mm256_set1_epi64x(0x00FF000000000000));
+			return (mlx_div255_avx2(_mm256_mullo_epi16(dst, factor)));
+		}
+		default:
+			return (mlx_div255_avx2(_mm256_add_epi16(_mm256_mullo_epi16(src, alpha), _mm256_mullo_epi16(dst, inverse))));
+	}
+}
+
+// Same as the SSE2 kernel with eight pixels at a time.
+__attribute__((target("avx2")))
+static void mlx_blit_avx2(uint8_t* dst, const uint8_t* src, size_t count, mlx_blend_t mode)
+{
+	const bool copy = mode == MLX_BLEND_ALPHA || mode == MLX_BLEND_PREMULTIPLIED;
+	const __m256i mask = _mm256_set1_epi32((int32_t)0xFF000000);
+	const __m256i zero = _mm256_setzero_si256();
+	size_t i = 0;
+
+	for (; i + 8 <= count; i += 8)
+	{
+		const __m256i pixels = _mm256_loadu_si256((const __m256i*)&src[i * BPP]);
+		const __m256i alpha = _mm256_and_si256(pixels, mask);
+
+		if (copy && (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(alpha, mask)) == UINT32_MAX)
+		{
+			_mm256_storeu_si256((__m256i*)&dst[i * BPP], pixels);
+			continue;
+		}
+
+		const __m256i empty = mode == MLX_BLEND_PREMULTIPLIED ? pixels : alpha;
+		if ((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(empty, zero)) == UINT32_MAX)
+			continue;
+
+		// Unpacking and packing both work within 128 bit lanes, so the order is kept.
+		const __m256i back = _mm256_loadu_si256((const __m256i*)&dst[i * BPP]);
+		const __m256i low = mlx_blit_wide_avx2(_mm256_unpacklo_epi8(pixels, zero), _mm256_unpacklo_epi8(back, zero), mode);
+		const __m256i high = mlx_blit_wide_avx2(_mm256_unpackhi_epi8(pixels, zero), _mm256_unpackhi_epi8(back, zero), mode);
+		_mm256_storeu_si256((__m256i*)&dst[i * BPP], _mm256_packus_epi16(low, high));
+	}
+	mlx_blit_sse2(&dst[i * BPP], &src[i * BPP], count - i, mode);
+}
+#endif
+
+#ifdef __aarch64__
+static void mlx_fill_neon(uint8_t* dst, uint32_t pixel, size_t count)
+{
+	const uint32x4_t pixels = vdupq_n_u32(pixel);
+	size_t i = 0;
+
+	for (; i + 4 <= count; i += 4)
+		vst1q_u32((uint32_t*)&dst[i * BPP], pixels);
+	mlx_fill_scalar(&dst[i * BPP], pixel, count - i);
+}
+
+static uint8x8_t mlx_div255_neon(uint16x8_t value)
+{
+	value = vaddq_u16(value, vdupq_n_u16(128));
+	return (vshrn_n_u16(vaddq_u16(value, vshrq_n_u16(value, 8)), 8));
+}
+
+static uint8x8_t mlx_blit_wide_neon(uint8x8_t src, uint8x8_t dst, uint8x8_t alpha, mlx_blend_t mode)
+{
+	const uint8x8_t full = vdup_n_u8(255);
+	const uint8x8_t inverse = vsub_u8(full, alpha);
+
+	switch (mode)
+	{
+		case MLX_BLEND_PREMULTIPLIED:
+			return (vqadd_u8(src, mlx_div255_neon(vmull_u8(dst, inverse))));
+		case MLX_BLEND_ADD:
+			return (vqadd_u8(dst, mlx_div255_neon(vmull_u8(src, alpha))));
+		case MLX_BLEND_MULTIPLY:
+		{
+			uint8x8_t factor = mlx_div255_neon(vmlal_u8(vmull_u8(src, alpha), full, inverse));
+			factor = vorr_u8(factor, vcreate_u8(0xFF000000FF000000));
+			return (mlx_div255_neon(vmull_u8(dst, factor)));
+		}
+		default:
+			return (mlx_div255_neon(vmlal_u8(vmull_u8(src, alpha), dst, inverse)));
+	}
+}
+
+static void mlx_blit_neon(uint8_t* dst, const uint8_t* src, size_t count, mlx_blend_t mode)
+{
+	const bool copy = mode == MLX_BLEND_ALPHA || mode == MLX_BLEND_PREMULTIPLIED;
+	const uint8x16_t spread = {3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15};
+	size_t i = 0;
+
+	for (; i + 4 <= count; i += 4)
+	{
+		const uint8x16_t pixels = vld1q_u8(&src[i * BPP]);
+		const uint8x16_t alpha = vqtbl1q_u8(pixels, spread);
+
+		if (copy && vminvq_u8(alpha) == 0xFF)
+		{
+			vst1q_u8(&dst[i * BPP], pixels);
+			continue;
+		}
+		if (vmaxvq_u8(mode == MLX_BLEND_PREMULTIPLIED ? pixels : alpha) == 0)
+			continue;
+
+		const uint8x16_t back = vld1q_u8(&dst[i * BPP]);
+		const uint8x8_t low = mlx_blit_wide_neon(vget_low_u8(pixels), vget_low_u8(back), vget_low_u8(alpha), mode);
+		const uint8x8_t high = mlx_blit_wide_neon(vget_high_u8(pixels), vget_high_u8(back), vget_high_u8(alpha), mode);
+		vst1q_u8(&dst[i * BPP], vcombine_u8(low, high));
+	}
+	mlx_blit_scalar(&dst[i * BPP], &src[i * BPP], count - i, mode);
+}
+#endif
+
+//= Public =//
+
+mlx_kernels_t mlx_kernels = {mlx_fill_scalar, mlx_blit_scalar, mlx_bilinear_scalar};
+
+/**
+ * Picks the fastest kernels the CPU supports, done once on startup.
+ */
+void mlx_init_kernels(void)
+{
+#ifdef MLX_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2"))
+		mlx_kernels = (mlx_kernels_t){mlx_fill_avx2, mlx_blit_avx2, mlx_bilinear_sse2};
+	else if (__builtin_cpu_supports("sse2"))
+		mlx_kernels = (mlx_kernels_t){mlx_fill_sse2, mlx_blit_sse2, mlx_bilinear_sse2};
+#elif defined(__aarch64__)
+	mlx_kernels = (mlx_kernels_t){mlx_fill_neon, mlx_blit_neon, mlx_bilinear_scalar};
+#endif
+}
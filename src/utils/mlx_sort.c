@@ -0,0 +1,162 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_sort.c                                         :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:32:25 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:06:24 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+//= Private =//
+
+// Below this many entries, insertion sort beats the radix sort.
+#define MLX_INSERTION_SORT 32
+
+// Maps the signed depth onto an unsigned key with the same order.
+#define MLX_SORT_KEY(z) ((uint32_t)(z) ^ 0x80000000)
+
+static void mlx_insertion_sort(draw_queue_t* queue, size_t count)
+{
+	for (size_t i = 1; i < count; i++)
+	{
+		const draw_queue_t entry = queue[i];
+
+		size_t j = i;
+		for (; j > 0 && queue[j - 1].z > entry.z; j--)
+			queue[j] = queue[j - 1];
+		queue[j] = entry;
+	}
+}
+
+/**
+ * Stable LSD radix sort on the depth, a byte at a time.
+ * 
+ * The histograms of all bytes are built in a single pass, passes for
+ * a byte that is the same for every entry are skipped entirely. Usually
+ * depths are small, so that's most of them.
+ * 
+ * @param queue The entries to sort.
+ * @param temp Scratch space, as big as the queue.
+ * @param count The amount of entries.
+ */
+static void mlx_radix_sort(draw_queue_t* queue, draw_queue_t* temp, size_t count)
+{
+	size_t histogram[4][256] = {0};
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const uint32_t key = MLX_SORT_KEY(queue[i].z);
+		histogram[0][key & 0xFF]++;
+		histogram[1][(key >> 8) & 0xFF]++;
+		histogram[2][(key >> 16) & 0xFF]++;
+		histogram[3][key >> 24]++;
+	}
+
+	draw_queue_t* src = queue;
+	draw_queue_t* dst = temp;
+	for (size_t pass = 0; pass < 4; pass++)
+	{
+		const uint32_t shift = pass * 8;
+		size_t* const offsets = histogram[pass];
+		if (offsets[(MLX_SORT_KEY(src[0].z) >> shift) & 0xFF] == count)
+			continue;
+
+		// Turn the histogram into offsets, then scatter.
+		for (size_t i = 0, total = 0; i < 256; i++)
+		{
+			const size_t amount = offsets[i];
+			offsets[i] = total;
+			total += amount;
+		}
+		for (size_t i = 0; i < count; i++)
+			dst[offsets[(MLX_SORT_KEY(src[i].z) >> shift) & 0xFF]++] = src[i];
+
+		draw_queue_t* const swap = src;
+		src = dst;
+		dst = swap;
+	}
+	if (src != queue)
+		memcpy(queue, src, count * sizeof(draw_queue_t));
+}
+
+static bool mlx_grow_sortbuffer(mlx_ctx_t* mlx)
+{
+	if (mlx->sort_capacity >= mlx->render_capacity)
+		return (true);
+
+	// Room for the moved entries and the radix sort's scratch space.
+	draw_queue_t* buffer;
+	if (!(buffer = realloc(mlx->sort_buffer, mlx->render_capacity * 2 * sizeof(draw_queue_t))))
+		return (false);
+	mlx->sort_buffer = buffer;
+	mlx->sort_capacity = mlx->render_capacity;
+	return (true);
+}
+
+/**
+ * Sorts the render queue by depth, we need to do this to fix transparency.
+ * 
+ * The queue was sorted the previous time, so only the entries whose depth
+ * changed or that were added since actually need to move. Those are pulled
+ * out while the rest stays in place, still in order. The few pulled out
+ * entries get sorted on their own and merged back into the queue.
+ * 
+ * If every entry changed this simply degrades into a radix sort.
+ * Entries of equal depth keep their order in the queue, except that an
+ * entry whose depth changed goes after those that already had its new depth.
+ * 
+ * @param mlx The MLX instance context.
+ */
+void mlx_sort_renderqueue(mlx_ctx_t* mlx)
+{
+	draw_queue_t* const queue = mlx->render_queue;
+
+	mlx->stats.current.sorts++;
+	if (!mlx_grow_sortbuffer(mlx))
+	{
+		for (size_t i = 0; i < mlx->render_count; i++)
+			queue[i].z = queue[i].image->instances[queue[i].instanceid].z;
+		mlx_insertion_sort(queue, mlx->render_count);
+		return;
+	}
+
+	// Pull out the entries that are out of place.
+	size_t kept = 0;
+	size_t moved = 0;
+	draw_queue_t* const buffer = mlx->sort_buffer;
+	for (size_t i = 0; i < mlx->render_count; i++)
+	{
+		draw_queue_t entry = queue[i];
+		const int32_t z = entry.image->instances[entry.instanceid].z;
+
+		if (z == entry.z && (kept == 0 || queue[kept - 1].z <= z))
+			queue[kept++] = entry;
+		else
+		{
+			entry.z = z;
+			buffer[moved++] = entry;
+		}
+	}
+	if (moved == 0)
+		return;
+
+	if (moved <= MLX_INSERTION_SORT)
+		mlx_insertion_sort(buffer, moved);
+	else
+		mlx_radix_sort(buffer, buffer + mlx->sort_capacity, moved);
+
+	// Merge back to front, on ties the moved entry goes last.
+	size_t out = kept + moved;
+	while (moved > 0)
+	{
+		if (kept > 0 && queue[kept - 1].z > buffer[moved - 1].z)
+			queue[--out] = queue[--kept];
+		else
+			queue[--out] = buffer[--moved];
+	}
+}
@@ -0,0 +1,131 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   atlas_test.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 08:06:57 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:06:57 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+
+#define WIDTH 64
+#define HEIGHT 48
+#define SMALL 20
+#define BIG 20
+#define FRAMES 4
+
+static uint8_t frames[FRAMES][WIDTH * HEIGHT * 4];
+static mlx_image_t* small[SMALL];
+static mlx_frame_stats_t stats[FRAMES];
+static size_t remaining = 0;
+
+static uint32_t ft_color(uint32_t i, uint32_t x, uint32_t y)
+{
+	return ((i * 12) << 24 | (x * 16) << 16 | (y * 16) << 8 | 0xFF);
+}
+
+static void ft_frame(void* param)
+{
+	static uint32_t frame = 0;
+	mlx_t* const mlx = param;
+
+	if (frame > 0)
+		mlx_get_frame_stats(mlx, &stats[frame - 1]);
+
+	// Its spot is reclaimed by repacking the others, which uploads them again.
+	if (frame == 1)
+	{
+		mlx_delete_image(mlx, small[0]);
+		for (uint32_t i = 1; i < SMALL; i++)
+			remaining += small[i]->width * small[i]->height * 4;
+	}
+
+	// Images over 256 pixels get a texture of their own, too many for a batch.
+	if (frame == 2)
+	{
+		for (uint32_t i = 0; i < BIG; i++)
+		{
+			mlx_image_t* big = mlx_new_image(mlx, 257, 2);
+			assert(big);
+			for (uint32_t p = 0; p < 257 * 2; p++)
+				mlx_put_pixel(big, p % 257, p / 257, ft_color(i, 1, 1));
+			const int32_t index = mlx_image_to_window(mlx, big, -200, HEIGHT - 2);
+			assert(index == 0);
+		}
+	}
+	if (frame == FRAMES)
+		mlx_close_window(mlx);
+	else
+		mlx_read_framebuffer(mlx, frames[frame]);
+	frame++;
+}
+
+static uint32_t ft_pixel(uint32_t frame, uint32_t x, uint32_t y)
+{
+	const uint8_t* pixel = &frames[frame][(y * WIDTH + x) * 4];
+
+	return ((uint32_t)pixel[0] << 24 | pixel[1] << 16 | pixel[2] << 8 | pixel[3]);
+}
+
+// Every pixel of every small image shows up where it should, nothing else.
+static void ft_check(uint32_t frame, uint32_t first)
+{
+	for (uint32_t i = 0; i < SMALL; i++)
+	{
+		const uint32_t cx = (i % 5) * 12;
+		const uint32_t cy = (i / 5) * 12;
+
+		for (uint32_t y = 0; y < 10; y++)
+			for (uint32_t x = 0; x < 10; x++)
+			{
+				const bool inside = i >= first && x < 4 + (i % 4) * 2 && y < 4 + (i % 3) * 2;
+				assert(ft_pixel(frame, cx + x, cy + y) == (inside ? ft_color(i, x, y) : 0x333333FF));
+			}
+	}
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("img_atlas");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_set_setting(MLX_DIRTY_TRACKING, true);
+	mlx_t* mlx = mlx_init(WIDTH, HEIGHT, "TEST", false);
+	assert(mlx);
+
+	for (uint32_t i = 0; i < SMALL; i++)
+	{
+		const uint32_t width = 4 + (i % 4) * 2;
+		const uint32_t height = 4 + (i % 3) * 2;
+
+		small[i] = mlx_new_image(mlx, width, height);
+		assert(small[i]);
+		for (uint32_t y = 0; y < height; y++)
+			for (uint32_t x = 0; x < width; x++)
+				mlx_put_pixel(small[i], x, y, ft_color(i, x, y));
+		const int32_t index = mlx_image_to_window(mlx, small[i], (i % 5) * 12, (i / 5) * 12);
+		assert(index == 0);
+	}
+	mlx_loop_hook(mlx, ft_frame, mlx);
+	mlx_loop(mlx);
+	mlx_terminate(mlx);
+
+	// All small images come out of a single atlas texture.
+	ft_check(0, 0);
+	assert(stats[0].batches == 1 && stats[0].draw_calls == 1);
+
+	ft_check(1, 1);
+	assert(stats[1].upload_bytes == remaining);
+
+	// New images only fit the depth range from the frame after they were added.
+	ft_check(3, 1);
+	assert(ft_pixel(3, 0, HEIGHT - 1) == ft_color(BIG - 1, 1, 1));
+	assert(stats[3].batches >= 2);
+	TEST_EXIT(EXIT_SUCCESS);
+}
@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   batch_test.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 08:10:23 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:10:23 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+
+#define WIDTH 128
+#define HEIGHT 96
+#define QUADS (WIDTH * HEIGHT)
+#define FRAMES 16
+
+static uint8_t frame[WIDTH * HEIGHT * 4];
+static mlx_image_t* red = NULL;
+static mlx_image_t* green = NULL;
+
+// Lays the instances out as a checkerboard that flips every frame.
+static void ft_layout(uint32_t flip)
+{
+	for (uint32_t k = 0; k < QUADS / 2; k++)
+	{
+		const uint32_t s = ((2 * k) / WIDTH + flip) & 1;
+		const uint32_t r = 2 * k + s;
+		const uint32_t g = 2 * k + 1 - s;
+
+		red->instances[k].x = r % WIDTH;
+		red->instances[k].y = r / WIDTH;
+		green->instances[k].x = g % WIDTH;
+		green->instances[k].y = g / WIDTH;
+	}
+}
+
+static uint32_t ft_pixel(uint32_t x, uint32_t y)
+{
+	const uint8_t* pixel = &frame[(y * WIDTH + x) * 4];
+
+	return ((uint32_t)pixel[0] << 24 | pixel[1] << 16 | pixel[2] << 8 | pixel[3]);
+}
+
+// Checks the frame that was read back, and lays out the next one.
+static void ft_frame(void* param)
+{
+	static uint32_t count = 0;
+	mlx_t* const mlx = param;
+	mlx_frame_stats_t stats;
+
+	if (count > 0)
+	{
+		for (uint32_t y = 0; y < HEIGHT; y++)
+			for (uint32_t x = 0; x < WIDTH; x++)
+				assert(ft_pixel(x, y) == ((x + y + count - 1) % 2 ? 0x00FF00FF : 0xFF0000FF));
+
+		// The queue alternates between the two, so nothing is drawn instanced.
+		mlx_get_frame_stats(mlx, &stats);
+		assert(stats.instances == QUADS);
+		assert(stats.batches == QUADS / 4096 && stats.draw_calls == stats.batches);
+	}
+	if (count == FRAMES)
+	{
+		mlx_close_window(mlx);
+		return;
+	}
+	ft_layout(count & 1);
+	mlx_read_framebuffer(mlx, frame);
+	count++;
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("img_batch");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_t* mlx = mlx_init(WIDTH, HEIGHT, "TEST", false);
+	assert(mlx);
+
+	red = mlx_new_image(mlx, 1, 1);
+	green = mlx_new_image(mlx, 1, 1);
+	assert(red && green);
+	mlx_put_pixel(red, 0, 0, 0xFF0000FF);
+	mlx_put_pixel(green, 0, 0, 0x00FF00FF);
+
+	// A frame takes a few batches, so the ring wraps around its sections.
+	for (uint32_t k = 0; k < QUADS / 2; k++)
+	{
+		const int32_t r = mlx_image_to_window(mlx, red, 0, 0);
+		const int32_t g = mlx_image_to_window(mlx, green, 0, 0);
+		assert(r == (int32_t)k && g == (int32_t)k);
+	}
+	mlx_loop_hook(mlx, ft_frame, mlx);
+	mlx_loop(mlx);
+	assert(mlx_errno == MLX_SUCCESS);
+	mlx_terminate(mlx);
+	TEST_EXIT(EXIT_SUCCESS);
+}
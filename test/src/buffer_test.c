@@ -0,0 +1,144 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   buffer_test.c                                      :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:24:17 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:19:20 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+#include "MLX42/MLX42_Int.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#define SIZE 16
+#define FRAMES 32
+
+static uint8_t frames[FRAMES][SIZE * SIZE * 4];
+static mlx_image_t* img = NULL;
+static atomic_bool stop;
+static atomic_uint published;
+
+static void ft_fill(uint32_t color)
+{
+	for (uint32_t y = 0; y < SIZE; y++)
+		for (uint32_t x = 0; x < SIZE; x++)
+			mlx_put_pixel_unsafe(img, x, y, color);
+}
+
+// Draws frame after frame in a color of its own, as fast as it can.
+static void* ft_producer(void* param)
+{
+	(void)param;
+	for (uint32_t i = 1; !atomic_load(&stop); i++)
+	{
+		const uint32_t color = (i * 0x9E3779B1) | 0xFF;
+		ft_fill(color);
+		mlx_image_swap(img);
+		atomic_store(&published, color);
+	}
+	return (NULL);
+}
+
+static void ft_frame(void* param)
+{
+	static uint32_t frame = 0;
+	static pthread_t thread;
+	mlx_t* const mlx = param;
+
+	if (frame == 1)
+		assert(pthread_create(&thread, NULL, ft_producer, NULL) == 0);
+	mlx_read_framebuffer(mlx, frames[frame]);
+	if (++frame < FRAMES)
+		return;
+	while (atomic_load(&published) == 0)
+		usleep(100);
+	atomic_store(&stop, true);
+	pthread_join(thread, NULL);
+	mlx_close_window(mlx);
+}
+
+// Pushes never straddle two sections and wrap around the ring lap after lap.
+static void ft_ring(void)
+{
+	const size_t section = 1024;
+	uint8_t data[400];
+	uint8_t read[sizeof(data)];
+	mlx_ring_t ring;
+	size_t last = 0;
+	uint32_t laps = 0;
+
+	mlx_create_ring(&ring, section * MLX_RING_SECTIONS);
+	for (uint32_t i = 0; i < 64; i++)
+	{
+		memset(data, i, sizeof(data));
+		const size_t offset = mlx_ring_push(&ring, data, sizeof(data), 24);
+		assert(offset / section == (offset + sizeof(data) - 1) / section);
+		assert(offset / section == ring.section);
+		assert(offset % section == 0 || offset % 24 == 0);
+		laps += offset < last;
+		last = offset;
+
+		glBindBuffer(GL_ARRAY_BUFFER, ring.buffer);
+		glGetBufferSubData(GL_ARRAY_BUFFER, offset, sizeof(read), read);
+		assert(memcmp(data, read, sizeof(data)) == 0);
+	}
+	assert(laps >= 4 && ring.pushed == 64 * sizeof(data));
+	for (uint32_t i = 0; i < MLX_RING_SECTIONS; i++)
+		mlx_wait_sync(&ring.fences[i]);
+	glDeleteBuffers(1, &ring.buffer);
+}
+
+// Every frame shows a single swap of the image, never parts of two.
+static bool ft_whole(const uint8_t* frame)
+{
+	return (memcmp(frame, frame + 4, (SIZE * SIZE - 1) * 4) == 0);
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("img_buffer");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_t* mlx = mlx_init(SIZE, SIZE, "TEST", false);
+	assert(mlx);
+
+	img = mlx_new_image(mlx, SIZE, SIZE);
+	assert(img);
+	assert(mlx_set_image_buffering(img, true));
+	assert(mlx_set_image_buffering(img, true));
+
+	// Pixels drawn after the swap are not published yet.
+	uint8_t* const back = img->pixels;
+	ft_fill(0xFF0000FF);
+	mlx_image_swap(img);
+	assert(img->pixels != back);
+	ft_fill(0x0000FFFF);
+	mlx_image_to_window(mlx, img, 0, 0);
+	mlx_loop_hook(mlx, ft_frame, mlx);
+	mlx_loop(mlx);
+	assert(mlx_errno == MLX_SUCCESS);
+
+	assert(frames[0][0] == 0xFF && frames[0][2] == 0x00 && ft_whole(frames[0]));
+	for (uint32_t i = 1; i < FRAMES; i++)
+		assert(ft_whole(frames[i]));
+
+	// Disabling keeps the pixels that were published last.
+	assert(mlx_set_image_buffering(img, false));
+	assert(((uint32_t*)img->pixels)[0] == ((uint32_t*)img->pixels)[SIZE * SIZE - 1]);
+	assert(img->pixels[0] == atomic_load(&published) >> 24 && img->pixels[3] == 0xFF);
+	assert(mlx_resize_image(img, SIZE * 2, SIZE));
+	assert(mlx_set_image_buffering(img, true) && mlx_resize_image(img, SIZE, SIZE * 2));
+	mlx_image_swap(img);
+	mlx_delete_image(mlx, img);
+	ft_ring();
+	mlx_terminate(mlx);
+	TEST_EXIT(EXIT_SUCCESS);
+}
@@ -0,0 +1,136 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   command_test.c                                     :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:27:23 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:21:26 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#define THREADS 4
+#define MOVES 500
+#define MAX_FRAMES 10000
+
+// A full queue is not an error, posting again once a frame made room is.
+#define POST(call) while (!(call) && !atomic_load(&stop)) usleep(100)
+
+static mlx_t* mlx = NULL;
+static mlx_image_t* img = NULL;
+static mlx_image_t* doomed = NULL;
+static mlx_image_t* victims[2];
+static mlx_image_t* keep = NULL;
+static atomic_bool stop;
+static bool deleted = false;
+
+// Every thread moves an instance of its own around and hides another.
+static void* ft_worker(void* param)
+{
+	const int32_t id = (int32_t)(intptr_t)param;
+
+	for (int32_t i = 0; i <= MOVES; i++)
+		POST(mlx_post_instance_move(mlx, img, id * 2, i, id));
+	POST(mlx_post_instance_depth(mlx, img, id * 2 + 1, 1000 + id));
+	POST(mlx_post_instance_enabled(mlx, img, id * 2 + 1, false));
+	POST(mlx_post_image_to_window(mlx, img, id, id));
+	return (NULL);
+}
+
+// Changes waiting for an image that gets deleted are dropped, the rest stay in order.
+static void ft_victims(uint32_t phase)
+{
+	bool posted = true;
+
+	if (phase == 0)
+	{
+		posted &= mlx_post_instance_move(mlx, victims[0], 0, 1, 1);
+		posted &= mlx_post_instance_move(mlx, keep, 0, 7, 7);
+		mlx_delete_image(mlx, victims[0]);
+	}
+	else if (phase == 1)
+	{
+		assert(keep->instances[0].x == 7 && keep->instances[0].y == 7);
+		posted &= mlx_post_delete_image(mlx, victims[1]);
+		posted &= mlx_post_instance_move(mlx, victims[1], 0, 1, 1);
+		posted &= mlx_post_instance_move(mlx, keep, 0, 8, 8);
+	}
+	else
+		mlx_close_window(mlx);
+	assert(posted);
+}
+
+// Posts of a thread are applied in order, its new instance comes last.
+static void ft_frame(void* param)
+{
+	static uint32_t frame = 0;
+	static uint32_t phase = 0;
+	(void)param;
+
+	if (++frame >= MAX_FRAMES)
+		return (mlx_close_window(mlx));
+	if (deleted)
+		return (ft_victims(phase++));
+	if (img->count == THREADS * 3)
+		deleted = mlx_post_delete_image(mlx, doomed);
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("commands");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx = mlx_init(32, 32, "TEST", false);
+	assert(mlx);
+	img = mlx_new_image(mlx, 4, 4);
+	doomed = mlx_new_image(mlx, 4, 4);
+	assert(img && doomed);
+	for (int32_t i = 0; i < THREADS * 2; i++)
+		assert(mlx_image_to_window(mlx, img, 0, 0) == i);
+	assert(mlx_image_to_window(mlx, doomed, 0, 0) == 0);
+	for (int32_t i = 0; i < 2; i++)
+	{
+		victims[i] = mlx_new_image(mlx, 4, 4);
+		assert(victims[i]);
+		mlx_image_to_window(mlx, victims[i], 0, 0);
+	}
+	keep = mlx_new_image(mlx, 4, 4);
+	assert(keep);
+	mlx_image_to_window(mlx, keep, 0, 0);
+
+	// Nothing is applied until the loop gets to it, the workers wait for room.
+	uint32_t posted = 0;
+	while (mlx_post_instance_move(mlx, doomed, 0, 5, 5))
+		posted++;
+	assert(posted > 0 && doomed->instances[0].x == 0);
+
+	pthread_t threads[THREADS];
+	for (int32_t id = 0; id < THREADS; id++)
+		assert(pthread_create(&threads[id], NULL, ft_worker, (void*)(intptr_t)id) == 0);
+	mlx_loop_hook(mlx, ft_frame, mlx);
+	mlx_loop(mlx);
+	atomic_store(&stop, true);
+	for (int32_t id = 0; id < THREADS; id++)
+		pthread_join(threads[id], NULL);
+
+	assert(deleted && img->count == THREADS * 3);
+	assert(keep->instances[0].x == 8 && keep->instances[0].y == 8);
+	for (int32_t id = 0; id < THREADS; id++)
+	{
+		assert(img->instances[id * 2].x == MOVES && img->instances[id * 2].y == id);
+		assert(img->instances[id * 2].enabled && img->instances[id * 2 + 1].x == 0);
+		assert(img->instances[id * 2 + 1].z == 1000 + id && !img->instances[id * 2 + 1].enabled);
+		assert(img->instances[THREADS * 2 + id].enabled);
+	}
+	assert(mlx_errno == MLX_SUCCESS);
+	mlx_terminate(mlx);
+	TEST_EXIT(EXIT_SUCCESS);
+}
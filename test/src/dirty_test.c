@@ -0,0 +1,55 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   dirty_test.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:26:51 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 06:26:51 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+
+static mlx_image_t* img = NULL;
+
+// Modify a different part of the image every frame.
+static void ft_draw(void* param)
+{
+	static uint32_t frame = 0;
+	mlx_t* const mlx = param;
+
+	mlx_put_pixel(img, frame % img->width, frame % img->height, 0xFF0000FF);
+	memset(img->pixels, 255, img->width * sizeof(int32_t));
+	mlx_image_mark_dirty(img, 0, 0, img->width, 1);
+
+	// Regions outside of the image are clipped.
+	mlx_image_mark_dirty(img, 60, 60, 100, 100);
+	mlx_image_mark_dirty(img, 100, 100, 1, 1);
+	if (++frame >= 64)
+		mlx_close_window(mlx);
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("dirty_track");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_set_setting(MLX_DIRTY_TRACKING, true);
+	mlx_t* mlx = mlx_init(64, 64, "TEST", false);
+	assert(mlx);
+
+	img = mlx_new_image(mlx, 64, 64);
+	assert(img);
+	mlx_image_to_window(mlx, img, 0, 0);
+	assert(mlx_resize_image(img, 32, 32));
+
+	mlx_loop_hook(mlx, ft_draw, mlx);
+	mlx_loop(mlx);
+	assert(mlx_errno == MLX_SUCCESS);
+	mlx_terminate(mlx);
+	TEST_EXIT(EXIT_SUCCESS);
+}
@@ -0,0 +1,92 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   draw_test.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:02:35 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 07:13:30 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+
+static uint32_t ft_pixel(const mlx_image_t* img, uint32_t x, uint32_t y)
+{
+	const uint8_t* pixel = &img->pixels[(y * img->width + x) * 4];
+
+	return ((uint32_t)pixel[0] << 24 | pixel[1] << 16 | pixel[2] << 8 | pixel[3]);
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("bulk_draw");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_t* mlx = mlx_init(64, 64, "TEST", false);
+	assert(mlx);
+	mlx_image_t* img = mlx_new_image(mlx, 37, 29);
+	mlx_image_t* src = mlx_new_image(mlx, 16, 16);
+	assert(img && src);
+
+	mlx_clear_image(img, 0x112233FF);
+	assert(ft_pixel(img, 0, 0) == 0x112233FF && ft_pixel(img, 36, 28) == 0x112233FF);
+
+	// Rectangles and lines are clipped to the image.
+	mlx_fill_rect(img, -5, -5, 10, 10, 0xFF0000FF);
+	assert(ft_pixel(img, 4, 4) == 0xFF0000FF && ft_pixel(img, 5, 4) == 0x112233FF);
+	mlx_fill_rect(img, 30, 20, 100, 100, 0x00FF00FF);
+	assert(ft_pixel(img, 36, 28) == 0x00FF00FF && ft_pixel(img, 29, 28) == 0x112233FF);
+	mlx_fill_rect(img, 100, 100, 10, 10, 0xFFFFFFFF);
+	mlx_draw_hline(img, -3, 10, 40, 0x0000FFFF);
+	assert(ft_pixel(img, 0, 10) == 0x0000FFFF && ft_pixel(img, 36, 10) == 0x0000FFFF);
+	assert(ft_pixel(img, 0, 11) == 0x112233FF);
+	mlx_draw_vline(img, 20, 25, 10, 0xABCDEFFF);
+	assert(ft_pixel(img, 20, 25) == 0xABCDEFFF && ft_pixel(img, 20, 28) == 0xABCDEFFF);
+	assert(ft_pixel(img, 20, 24) == 0x112233FF);
+
+	// Copying within the same image works in either direction.
+	mlx_copy_rect(img, 2, 2, img, 0, 0, 8, 8);
+	assert(ft_pixel(img, 6, 6) == 0xFF0000FF && ft_pixel(img, 7, 7) == 0x112233FF);
+	mlx_copy_rect(img, -2, -2, img, 0, 0, 8, 8);
+	assert(ft_pixel(img, 0, 0) == 0xFF0000FF);
+
+	// Translucent pixels are blended like they are onto the window.
+	mlx_clear_image(src, 0x0000FF80);
+	mlx_put_pixel(src, 0, 0, 0xFFFFFF00);
+	mlx_blend_rect(img, 30, 0, src, 0, 0, 16, 16);
+	assert(ft_pixel(img, 30, 0) == 0x112233FF);
+	assert(ft_pixel(img, 31, 0) == 0x081199BF);
+	assert(ft_pixel(img, 31, 10) == 0x0000FFBF);
+	assert(ft_pixel(img, 29, 0) == 0x112233FF);
+
+	// Blend modes, with whatever is outside of the destination cut off.
+	mlx_texture_t texture = {2, 1, 4, (uint8_t[]){0x40, 0x80, 0xFF, 0x80, 0x40, 0x40, 0x40, 0x80}};
+	mlx_clear_image(img, 0x808080FF);
+	mlx_blit_texture(img, &texture, 0, 0, MLX_BLEND_ADD);
+	assert(ft_pixel(img, 0, 0) == 0xA0C0FFFF && ft_pixel(img, 1, 0) == 0xA0A0A0FF);
+	mlx_blit_texture(img, &texture, 0, 1, MLX_BLEND_MULTIPLY);
+	assert(ft_pixel(img, 0, 1) == 0x506080FF && ft_pixel(img, 1, 1) == 0x505050FF);
+	mlx_blit_texture(img, &texture, 0, 2, MLX_BLEND_PREMULTIPLIED);
+	assert(ft_pixel(img, 0, 2) == 0x80C0FFFF && ft_pixel(img, 1, 2) == 0x808080FF);
+	mlx_blit_texture(img, &texture, 36, 3, MLX_BLEND_ALPHA);
+	assert(ft_pixel(img, 36, 3) == 0x6080C0BF && ft_pixel(img, 0, 4) == 0x808080FF);
+	mlx_blit_image(img, src, -14, -14, MLX_BLEND_ALPHA);
+	assert(ft_pixel(img, 1, 1) == 0x2828A8BF && ft_pixel(img, 2, 2) == 0x808080FF);
+
+	// Scaled up twice and rotated by 90 degrees, sampling the nearest pixels.
+	mlx_clear_image(img, 0x000000FF);
+	mlx_transform_t transform = {2, 0, 0, 2, 4, 4};
+	mlx_blit_texture_transformed(NULL, img, &texture, &transform, MLX_FILTER_NEAREST, MLX_BLEND_PREMULTIPLIED);
+	assert(ft_pixel(img, 4, 4) == 0x4080FFFF && ft_pixel(img, 5, 5) == 0x4080FFFF && ft_pixel(img, 6, 4) == 0x404040FF);
+	assert(ft_pixel(img, 7, 5) == 0x404040FF && ft_pixel(img, 8, 4) == 0x000000FF && ft_pixel(img, 4, 6) == 0x000000FF);
+	transform = (mlx_transform_t){0, -1, 1, 0, 20, 10};
+	mlx_blit_texture_transformed(mlx, img, &texture, &transform, MLX_FILTER_BILINEAR, MLX_BLEND_PREMULTIPLIED);
+	assert(ft_pixel(img, 19, 10) == 0x4080FFFF && ft_pixel(img, 19, 11) == 0x404040FF && ft_pixel(img, 20, 10) == 0x000000FF);
+
+	mlx_terminate(mlx);
+	TEST_EXIT(EXIT_SUCCESS);
+}
@@ -0,0 +1,144 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   group_test.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:43:39 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:25:53 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+
+#define COUNT 64
+
+static mlx_image_t* frames[COUNT];
+
+// Cycle through the frames like an animated sprite would.
+static void ft_animate(void* param)
+{
+	static uint32_t frame = 0;
+	mlx_t* const mlx = param;
+
+	mlx_put_pixel(frames[frame % COUNT], 0, 0, 0xFF0000FF);
+	frames[frame % COUNT]->enabled = !frames[frame % COUNT]->enabled;
+	if (++frame >= COUNT * 2)
+		mlx_close_window(mlx);
+}
+
+#define WIDTH 32
+#define HEIGHT 16
+
+static uint8_t pixels[WIDTH * HEIGHT * 4];
+static mlx_frame_stats_t stats;
+
+static uint32_t ft_color(uint32_t kind, uint32_t x, uint32_t y)
+{
+	return ((kind * 60 + x * 4) << 24 | (y * 12) << 16 | 0x40 << 8 | 0xFF);
+}
+
+static void ft_read(void* param)
+{
+	static uint32_t frame = 0;
+	mlx_t* const mlx = param;
+
+	if (frame++ == 0)
+		return (mlx_read_framebuffer(mlx, pixels));
+	mlx_get_frame_stats(mlx, &stats);
+	mlx_close_window(mlx);
+}
+
+static uint32_t ft_pixel(uint32_t x, uint32_t y)
+{
+	const uint8_t* pixel = &pixels[(y * WIDTH + x) * 4];
+
+	return ((uint32_t)pixel[0] << 24 | pixel[1] << 16 | pixel[2] << 8 | pixel[3]);
+}
+
+// Two layers of a group drawn in one batch with images of plain textures.
+static void ft_layers(void)
+{
+	mlx_t* mlx = mlx_init(WIDTH, HEIGHT, "TEST", false);
+	assert(mlx);
+
+	mlx_image_t* layers[2];
+	assert(mlx_new_image_group(mlx, 8, 8, 2, layers));
+	mlx_image_t* big = mlx_new_image(mlx, 257, 4);
+	mlx_image_t* small = mlx_new_image(mlx, 4, 4);
+	assert(big && small);
+	for (uint32_t y = 0; y < 8; y++)
+		for (uint32_t x = 0; x < 8; x++)
+			for (uint32_t i = 0; i < 2; i++)
+				mlx_put_pixel(layers[i], x, y, ft_color(i, x, y));
+	for (uint32_t y = 0; y < 4; y++)
+		for (uint32_t x = 0; x < 257; x++)
+			mlx_put_pixel(big, x, y, ft_color(2, x % 16, y));
+	for (uint32_t y = 0; y < 4; y++)
+		for (uint32_t x = 0; x < 4; x++)
+			mlx_put_pixel(small, x, y, ft_color(3, x, y));
+
+	// Interleaved so the array and the plain textures are bound side by side.
+	mlx_image_to_window(mlx, layers[0], 0, 0);
+	mlx_image_to_window(mlx, big, -241, 12);
+	mlx_image_to_window(mlx, layers[1], 8, 0);
+	mlx_image_to_window(mlx, small, 20, 0);
+	mlx_loop_hook(mlx, ft_read, mlx);
+	mlx_loop(mlx);
+	assert(mlx_errno == MLX_SUCCESS);
+	mlx_terminate(mlx);
+
+	assert(stats.batches == 1);
+	for (uint32_t y = 0; y < HEIGHT; y++)
+	{
+		for (uint32_t x = 0; x < WIDTH; x++)
+		{
+			uint32_t expected = 0x333333FF;
+			if (y < 8 && x < 16)
+				expected = ft_color(x / 8, x % 8, y);
+			else if (y >= 12 && x < 16)
+				expected = ft_color(2, (x + 241) % 16, y - 12);
+			else if (y < 4 && x >= 20 && x < 24)
+				expected = ft_color(3, x - 20, y);
+			assert(ft_pixel(x, y) == expected);
+		}
+	}
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("img_group");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_t* mlx = mlx_init(256, 256, "TEST", false);
+	assert(mlx);
+
+	assert(!mlx_new_image_group(mlx, 16, 16, 0, frames));
+	assert(mlx_errno == MLX_INVDIM);
+	mlx_errno = MLX_SUCCESS;
+
+	assert(mlx_new_image_group(mlx, 16, 16, COUNT, frames));
+	for (int32_t i = 0; i < COUNT; i++)
+	{
+		assert(frames[i]->width == 16 && frames[i]->height == 16);
+		memset(frames[i]->pixels, i * 4, 16 * 16 * sizeof(int32_t));
+		mlx_image_to_window(mlx, frames[i], (i % 16) * 16, (i / 16) * 16);
+	}
+
+	// Images can still leave the group.
+	assert(mlx_resize_image(frames[1], 32, 32));
+	assert(mlx_set_image_streaming(frames[2], true));
+	mlx_delete_image(mlx, frames[3]);
+	frames[3] = frames[4];
+
+	mlx_loop_hook(mlx, ft_animate, mlx);
+	mlx_loop(mlx);
+	assert(mlx_errno == MLX_SUCCESS);
+	mlx_terminate(mlx);
+
+	ft_layers();
+	TEST_EXIT(EXIT_SUCCESS);
+}
@@ -0,0 +1,78 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   instanced_test.c                                   :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 08:02:52 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:02:52 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+
+#define WIDTH 64
+#define HEIGHT 48
+#define FRAMES 3
+#define RUN 8
+
+static uint8_t frames[FRAMES][WIDTH * HEIGHT * 4];
+
+static void ft_read(void* param)
+{
+	static uint32_t frame = 0;
+	mlx_t* const mlx = param;
+
+	mlx_read_framebuffer(mlx, frames[frame]);
+	if (++frame >= FRAMES)
+		mlx_close_window(mlx);
+}
+
+static uint32_t ft_pixel(uint32_t frame, uint32_t x, uint32_t y)
+{
+	const uint8_t* pixel = &frames[frame][(y * WIDTH + x) * 4];
+
+	return ((uint32_t)pixel[0] << 24 | pixel[1] << 16 | pixel[2] << 8 | pixel[3]);
+}
+
+// Too wide for the atlas, so both images have a texture of their own.
+static mlx_image_t* ft_run(mlx_t* mlx, uint32_t color, int32_t y)
+{
+	mlx_image_t* img = mlx_new_image(mlx, 300, 2);
+	assert(img);
+	for (uint32_t i = 0; i < 300 * 2; i++)
+		mlx_put_pixel(img, i % 300, i / 300, color);
+	for (int32_t i = 0; i < RUN; i++)
+		assert(mlx_image_to_window(mlx, img, i * 8, y) == i);
+	return (img);
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("instanced");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_t* mlx = mlx_init(WIDTH, HEIGHT, "TEST", false);
+	assert(mlx);
+
+	// Two runs long enough to be drawn instanced, every frame re-uploads both.
+	ft_run(mlx, 0xFF0000FF, 0);
+	ft_run(mlx, 0x00FF00FF, 16);
+	mlx_loop_hook(mlx, ft_read, mlx);
+	mlx_loop(mlx);
+	mlx_terminate(mlx);
+
+	// Each run samples its own texture, also after uploads bound others.
+	for (uint32_t frame = 0; frame < FRAMES; frame++)
+	{
+		assert(ft_pixel(frame, 0, 0) == 0xFF0000FF);
+		assert(ft_pixel(frame, WIDTH - 1, 1) == 0xFF0000FF);
+		assert(ft_pixel(frame, 0, 16) == 0x00FF00FF);
+		assert(ft_pixel(frame, WIDTH - 1, 17) == 0x00FF00FF);
+		assert(ft_pixel(frame, 0, 8) == 0x333333FF);
+	}
+	TEST_EXIT(EXIT_SUCCESS);
+}
@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   parallel_test.c                                    :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:15:12 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 07:15:12 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+#include <stdatomic.h>
+
+static atomic_uint tiles;
+
+// Adds one to every pixel of the tile, so pixels rendered twice stand out.
+static void ft_tile(mlx_image_t* image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, void* param)
+{
+	(void)param;
+	assert(x + width <= image->width && y + height <= image->height);
+	for (uint32_t row = y; row < y + height; row++)
+		for (uint32_t col = x; col < x + width; col++)
+			((uint32_t*)image->pixels)[row * image->width + col] += 1;
+	atomic_fetch_add(&tiles, 1);
+}
+
+// Renders the whole image again from within a single tile.
+static void ft_nested(mlx_image_t* image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, void* param)
+{
+	(void)x, (void)y, (void)width, (void)height;
+	assert(mlx_parallel_tiles(param, image, 16, 16, ft_tile, NULL));
+}
+
+static bool ft_all(const mlx_image_t* image, uint32_t value)
+{
+	for (uint32_t i = 0; i < image->width * image->height; i++)
+		if (((uint32_t*)image->pixels)[i] != value)
+			return (false);
+	return (true);
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("parallel_tiles");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_set_setting(MLX_THREADS, 4);
+	mlx_t* mlx = mlx_init(32, 32, "TEST", false);
+	assert(mlx);
+	mlx_image_t* img = mlx_new_image(mlx, 333, 199);
+	assert(img);
+
+	// Tiles at the edges are cut off to fit the image.
+	assert(mlx_parallel_tiles(mlx, img, 0, 0, ft_tile, NULL));
+	assert(atomic_load(&tiles) == 6 * 4 && ft_all(img, 1));
+	assert(mlx_parallel_tiles(mlx, img, img->width, 1, ft_tile, NULL));
+	assert(atomic_load(&tiles) == 6 * 4 + 199 && ft_all(img, 2));
+	assert(mlx_parallel_tiles(mlx, img, 7, 1000, ft_tile, NULL));
+	assert(ft_all(img, 3));
+	assert(mlx_parallel_tiles(mlx, img, img->width, img->height, ft_nested, mlx));
+	assert(ft_all(img, 4));
+
+	mlx_terminate(mlx);
+	TEST_EXIT(EXIT_SUCCESS);
+}
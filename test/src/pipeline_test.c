@@ -0,0 +1,98 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   pipeline_test.c                                    :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 08:01:43 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:01:43 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+
+#define WIDTH 64
+#define HEIGHT 48
+#define FRAMES 5
+
+static const uint32_t colors[FRAMES] = {0xFF0000FF, 0x00FF00FF, 0x0000FFFF, 0xFFFF00FF, 0x00FFFFFF};
+static uint8_t frames[FRAMES][WIDTH * HEIGHT * 4];
+static mlx_image_t* img = NULL;
+static mlx_image_t* tile = NULL;
+static mlx_image_t* extra = NULL;
+static uint32_t drawn = 0;
+
+static void ft_fill(mlx_image_t* image, uint32_t color)
+{
+	for (uint32_t y = 0; y < image->height; y++)
+		for (uint32_t x = 0; x < image->width; x++)
+			mlx_put_pixel(image, x, y, color);
+}
+
+// Everything changes again while the previous frame is still being drawn.
+static void ft_frame(void* param)
+{
+	static uint32_t frame = 0;
+	mlx_t* const mlx = param;
+
+	mlx_frame_stats_t stats;
+	mlx_get_frame_stats(mlx, &stats);
+	drawn += stats.instances;
+
+	img->instances[0].y = frame;
+	if (frame == 1)
+		assert(mlx_resize_image(tile, 16, 16));
+	ft_fill(tile, colors[frame]);
+	if (frame == 2)
+	{
+		assert((extra = mlx_new_image(mlx, 8, 8)));
+		ft_fill(extra, 0xFFFFFFFF);
+		assert(mlx_image_to_window(mlx, extra, 40, 0) >= 0);
+	}
+	if (frame == 3)
+		mlx_delete_image(mlx, extra);
+	mlx_read_framebuffer(mlx, frames[frame]);
+	if (++frame >= FRAMES)
+		mlx_close_window(mlx);
+}
+
+static uint32_t ft_pixel(uint32_t frame, uint32_t x, uint32_t y)
+{
+	const uint8_t* pixel = &frames[frame][(y * WIDTH + x) * 4];
+
+	return ((uint32_t)pixel[0] << 24 | pixel[1] << 16 | pixel[2] << 8 | pixel[3]);
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("pipeline");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_set_setting(MLX_PIPELINED, true);
+	mlx_t* mlx = mlx_init(WIDTH, HEIGHT, "TEST", false);
+	assert(mlx);
+
+	assert((img = mlx_new_image(mlx, 8, 8)));
+	assert((tile = mlx_new_image(mlx, 8, 8)));
+	ft_fill(img, 0xFFFFFFFF);
+	mlx_image_to_window(mlx, img, 0, 0);
+	mlx_image_to_window(mlx, tile, 16, 0);
+	mlx_loop_hook(mlx, ft_frame, mlx);
+	mlx_loop(mlx);
+	mlx_terminate(mlx);
+
+	// Each frame shows the state its hooks left behind.
+	for (uint32_t frame = 0; frame < FRAMES; frame++)
+	{
+		assert(ft_pixel(frame, 0, frame) == 0xFFFFFFFF);
+		assert(ft_pixel(frame, 0, frame + 8) == 0x333333FF);
+		assert(ft_pixel(frame, 16, 0) == colors[frame]);
+		assert(ft_pixel(frame, 31, 15) == (frame >= 1 ? colors[frame] : 0x333333FF));
+		assert(ft_pixel(frame, 40, 0) == (frame == 2 ? 0xFFFFFFFF : 0x333333FF));
+	}
+	assert(drawn > 0);
+	TEST_EXIT(EXIT_SUCCESS);
+}
@@ -0,0 +1,132 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   progressive_test.c                                 :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 07:21:14 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:27:07 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+#include "MLX42/MLX42_Int.h"
+#include <stdatomic.h>
+#include <unistd.h>
+
+#define SIZE 32
+#define TILE 16
+#define TILE_BYTES (TILE * TILE * 4)
+
+static uint8_t frames[2][SIZE * SIZE * 4];
+static mlx_image_t* img = NULL;
+static atomic_uint tiles;
+static atomic_bool release;
+
+// The bottom tiles wait until they're released, the top ones are done right away.
+static void ft_tile(mlx_image_t* image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, void* param)
+{
+	(void)param;
+	while (y >= SIZE / 2 && !atomic_load(&release))
+		usleep(100);
+	for (uint32_t row = y; row < y + height; row++)
+		for (uint32_t col = x; col < x + width; col++)
+			mlx_put_pixel_unsafe(image, col, row, y ? 0x0000FFFF : 0xFF0000FF);
+	atomic_fetch_add(&tiles, 1);
+}
+
+static void ft_slow(mlx_image_t* image, uint32_t x, uint32_t y, uint32_t width, uint32_t height, void* param)
+{
+	(void)image, (void)x, (void)y, (void)width, (void)height, (void)param;
+	usleep(1000);
+	atomic_fetch_add(&tiles, 1);
+}
+
+// Only the tiles finished since the previous frame get uploaded.
+static void ft_frame(void* param)
+{
+	static uint32_t frame = 0;
+	mlx_t* const mlx = param;
+
+	mlx_frame_stats_t stats;
+	mlx_get_frame_stats(mlx, &stats);
+	switch (frame++)
+	{
+		case 0:
+			while (atomic_load(&tiles) < 2)
+				usleep(100);
+			break;
+		case 1:
+			assert(stats.upload_bytes == 2 * TILE_BYTES);
+			assert(!mlx_progressive_done(img));
+			mlx_read_framebuffer(mlx, frames[0]);
+			break;
+		case 2:
+			assert(stats.upload_bytes == 0);
+			atomic_store(&release, true);
+			while (!mlx_progressive_done(img))
+				usleep(100);
+			break;
+		case 3:
+			assert(stats.upload_bytes == 2 * TILE_BYTES);
+			mlx_read_framebuffer(mlx, frames[1]);
+			break;
+		default:
+			// The threads of the finished render were joined by now.
+			assert(stats.upload_bytes == SIZE * SIZE * 4);
+			assert(((mlx_image_ctx_t*)img->context)->progress == NULL);
+			mlx_close_window(mlx);
+	}
+}
+
+static uint32_t ft_pixel(uint32_t frame, uint32_t x, uint32_t y)
+{
+	const uint8_t* pixel = &frames[frame][(y * SIZE + x) * 4];
+
+	return ((uint32_t)pixel[0] << 24 | pixel[1] << 16 | pixel[2] << 8 | pixel[3]);
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("progressive");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_set_setting(MLX_FRAME_STATS, true);
+	mlx_set_setting(MLX_THREADS, 4);
+	mlx_t* mlx = mlx_init(SIZE, SIZE, "TEST", false);
+	assert(mlx);
+
+	img = mlx_new_image(mlx, SIZE, SIZE);
+	assert(img);
+	assert(mlx_progressive_done(img));
+	mlx_image_to_window(mlx, img, 0, 0);
+	assert(mlx_progressive_tiles(img, TILE, TILE, ft_tile, NULL));
+	mlx_loop_hook(mlx, ft_frame, mlx);
+	mlx_loop(mlx);
+	assert(mlx_errno == MLX_SUCCESS);
+
+	assert(ft_pixel(0, 0, 0) == 0xFF0000FF && ft_pixel(0, SIZE - 1, SIZE / 2 - 1) == 0xFF0000FF);
+	assert(ft_pixel(0, 0, SIZE - 1) != 0x0000FFFF);
+	assert(ft_pixel(1, 0, 0) == 0xFF0000FF && ft_pixel(1, SIZE - 1, SIZE - 1) == 0x0000FFFF);
+
+	// Cancelling waits for the tiles being worked on and skips the rest.
+	mlx_image_t* large = mlx_new_image(mlx, 256, 256);
+	assert(large);
+	atomic_store(&tiles, 0);
+	assert(mlx_progressive_tiles(large, 8, 8, ft_slow, NULL));
+	mlx_progressive_cancel(large);
+	const uint32_t rendered = atomic_load(&tiles);
+	assert(mlx_progressive_done(large) && rendered < 32 * 32);
+	usleep(5000);
+	assert(atomic_load(&tiles) == rendered);
+
+	// As does deleting the image or terminating while it renders.
+	assert(mlx_progressive_tiles(large, 8, 8, ft_slow, NULL));
+	assert(mlx_progressive_tiles(img, 1, 1, ft_slow, NULL));
+	mlx_delete_image(mlx, large);
+	mlx_terminate(mlx);
+	TEST_EXIT(EXIT_SUCCESS);
+}
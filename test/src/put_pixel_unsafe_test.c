@@ -0,0 +1,35 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   put_pixel_unsafe_test.c                            :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 08:11:42 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:11:42 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+
+int32_t main(void)
+{
+	TEST_DECLARE("put_pixel_unsafe");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_t* mlx = mlx_init(32, 32, "TEST", false);
+	mlx_image_t* img = mlx_new_image(mlx, 32, 32);
+
+	assert(mlx_errno == MLX_SUCCESS);
+
+	// Both variants store the color as R, G, B, A bytes.
+	mlx_put_pixel(img, 1, 0, 0x11223344);
+	mlx_put_pixel_unsafe(img, 2, 1, 0x11223344);
+	assert(img->pixels[4] == 0x11 && img->pixels[5] == 0x22 && img->pixels[6] == 0x33 && img->pixels[7] == 0x44);
+	assert(memcmp(&img->pixels[4], &img->pixels[(32 + 2) * 4], 4) == 0);
+
+	mlx_terminate(mlx);
+	TEST_EXIT(EXIT_SUCCESS);
+}
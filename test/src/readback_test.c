@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   readback_test.c                                    :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:56:12 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 06:56:12 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+
+#define WIDTH 64
+#define HEIGHT 48
+
+static uint8_t frames[4][WIDTH * HEIGHT * 4];
+static mlx_image_t* img = NULL;
+
+// Move the image down a row every frame and read every frame back.
+static void ft_read(void* param)
+{
+	static uint32_t frame = 0;
+	mlx_t* const mlx = param;
+
+	img->instances[0].y = frame;
+	mlx_read_framebuffer(mlx, frames[frame]);
+	if (++frame >= 4)
+		mlx_close_window(mlx);
+}
+
+static uint32_t ft_pixel(uint32_t frame, uint32_t x, uint32_t y)
+{
+	const uint8_t* pixel = &frames[frame][(y * WIDTH + x) * 4];
+
+	return ((uint32_t)pixel[0] << 24 | pixel[1] << 16 | pixel[2] << 8 | pixel[3]);
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("readback");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_t* mlx = mlx_init(WIDTH, HEIGHT, "TEST", false);
+	assert(mlx);
+
+	img = mlx_new_image(mlx, 8, 8);
+	assert(img);
+	memset(img->pixels, 0xFF, 8 * 8 * 4);
+	mlx_image_to_window(mlx, img, 0, 0);
+	mlx_loop_hook(mlx, ft_read, mlx);
+	mlx_loop(mlx);
+	mlx_terminate(mlx);
+
+	// Rows are top to bottom, like the pixels of an image.
+	for (uint32_t frame = 0; frame < 4; frame++)
+	{
+		assert(ft_pixel(frame, 0, frame) == 0xFFFFFFFF);
+		assert(ft_pixel(frame, 7, frame + 7) == 0xFFFFFFFF);
+		assert(ft_pixel(frame, 0, frame + 8) == 0x333333FF);
+		assert(ft_pixel(frame, WIDTH - 1, HEIGHT - 1) == 0x333333FF);
+	}
+	TEST_EXIT(EXIT_SUCCESS);
+}
@@ -0,0 +1,108 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   software_test.c                                    :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:59:58 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:28:05 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+
+#define WIDTH 64
+#define HEIGHT 80
+
+static uint8_t frame[WIDTH * HEIGHT * 4];
+
+static void ft_read(void* param)
+{
+	static uint32_t count = 0;
+	mlx_t* const mlx = param;
+
+	mlx_read_framebuffer(mlx, frame);
+	if (++count % 2 == 0)
+		mlx_close_window(mlx);
+}
+
+static uint32_t ft_pixel(uint32_t x, uint32_t y)
+{
+	const uint8_t* pixel = &frame[(y * WIDTH + x) * 4];
+
+	return ((uint32_t)pixel[0] << 24 | pixel[1] << 16 | pixel[2] << 8 | pixel[3]);
+}
+
+// Stretched images keep the initial size of the window, like with OpenGL.
+static void ft_stretch(void)
+{
+	mlx_set_setting(MLX_STRETCH_IMAGE, true);
+	mlx_t* mlx = mlx_init(WIDTH / 2, HEIGHT / 2, "TEST", false);
+	assert(mlx);
+
+	mlx_image_t* red = mlx_new_image(mlx, 8, 8);
+	assert(red);
+	for (uint32_t i = 0; i < 8 * 8; i++)
+		mlx_put_pixel(red, i % 8, i / 8, 0xFF0000FF);
+	mlx_image_to_window(mlx, red, 0, 0);
+	mlx_image_to_window(mlx, red, WIDTH / 2 - 4, HEIGHT / 2 - 4);
+	mlx_set_window_size(mlx, WIDTH, HEIGHT);
+
+	mlx_loop_hook(mlx, ft_read, mlx);
+	mlx_loop(mlx);
+	assert(mlx_errno == MLX_SUCCESS);
+	mlx_terminate(mlx);
+
+	assert(ft_pixel(0, 0) == 0xFF0000FF && ft_pixel(15, 15) == 0xFF0000FF);
+	assert(ft_pixel(16, 0) == 0x333333FF && ft_pixel(0, 16) == 0x333333FF);
+	assert(ft_pixel(WIDTH - 9, HEIGHT - 9) == 0x333333FF);
+	assert(ft_pixel(WIDTH - 8, HEIGHT - 8) == 0xFF0000FF);
+	assert(ft_pixel(WIDTH - 1, HEIGHT - 1) == 0xFF0000FF);
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("software");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_SOFTWARE, true);
+	mlx_t* mlx = mlx_init(WIDTH, HEIGHT, "TEST", false);
+	assert(mlx);
+
+	mlx_image_t* opaque = mlx_new_image(mlx, 16, 16);
+	mlx_image_t* half = mlx_new_image(mlx, 16, 16);
+	assert(opaque && half);
+	for (uint32_t i = 0; i < 16 * 16; i++)
+	{
+		mlx_put_pixel(opaque, i % 16, i / 16, 0xFF0000FF);
+		mlx_put_pixel(half, i % 16, i / 16, 0x0000FF80);
+	}
+
+	// Overlapping instances, one hidden and one pushed below the rest.
+	mlx_image_to_window(mlx, opaque, 0, 0);
+	mlx_image_to_window(mlx, half, 8, 8);
+	mlx_image_to_window(mlx, half, 40, 40);
+	const int32_t low = mlx_image_to_window(mlx, opaque, 40, 40);
+	mlx_set_instance_depth(&opaque->instances[low], -1);
+	const int32_t hidden = mlx_image_to_window(mlx, half, 40, 60);
+	half->instances[hidden].enabled = false;
+	mlx_image_to_window(mlx, opaque, -8, HEIGHT - 8);
+
+	mlx_loop_hook(mlx, ft_read, mlx);
+	mlx_loop(mlx);
+	assert(mlx_errno == MLX_SUCCESS);
+	mlx_terminate(mlx);
+
+	assert(ft_pixel(0, 0) == 0xFF0000FF);
+	assert(ft_pixel(12, 12) == 0x7F0080BF);
+	assert(ft_pixel(20, 20) == 0x191999BF);
+	assert(ft_pixel(44, 44) == 0x7F0080BF);
+	assert(ft_pixel(44, 64) == 0x333333FF);
+	assert(ft_pixel(0, HEIGHT - 1) == 0xFF0000FF);
+	assert(ft_pixel(8, HEIGHT - 1) == 0x333333FF);
+
+	ft_stretch();
+	TEST_EXIT(EXIT_SUCCESS);
+}
@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   sort_test.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 08:05:51 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:05:51 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+
+#define WIDTH 48
+#define HEIGHT 4
+#define FRAMES 6
+#define RED 0xFF0000FF
+#define GREEN 0x00FF00FF
+
+static uint8_t frames[FRAMES][WIDTH * HEIGHT * 4];
+static mlx_image_t* red = NULL;
+static mlx_image_t* green = NULL;
+
+/**
+ * Each column has a red and a green instance on top of each other, the
+ * depths are shuffled around every frame. More than 32 changed entries
+ * take the radix sort, fewer the insertion sort.
+ */
+static void ft_frame(void* param)
+{
+	static int32_t frame = 0;
+	mlx_t* const mlx = param;
+
+	for (int32_t c = 0; c < WIDTH; c++)
+	{
+		mlx_instance_t* const r = &red->instances[c];
+		mlx_instance_t* const g = &green->instances[c];
+
+		if (frame == 1)
+		{
+			// Negative depths, even columns have green below red.
+			mlx_set_instance_depth(r, -c);
+			mlx_set_instance_depth(g, c % 2 == 0 ? -c - WIDTH : -c + WIDTH);
+		}
+		else if (frame == 2)
+			mlx_set_instance_depth(g, -c);
+		else if (frame == 3)
+			mlx_set_instance_depth(r, -c - WIDTH);
+		else if (frame == 4)
+			mlx_set_instance_depth(r, -c);
+		else if (frame == 5 && c < 4)
+			mlx_set_instance_depth(g, WIDTH);
+	}
+	mlx_read_framebuffer(mlx, frames[frame]);
+	if (++frame >= FRAMES)
+		mlx_close_window(mlx);
+}
+
+static uint32_t ft_pixel(uint32_t frame, uint32_t x, uint32_t y)
+{
+	const uint8_t* pixel = &frames[frame][(y * WIDTH + x) * 4];
+
+	return ((uint32_t)pixel[0] << 24 | pixel[1] << 16 | pixel[2] << 8 | pixel[3]);
+}
+
+// The color on top of each column after each frame.
+static uint32_t ft_expect(uint32_t frame, uint32_t c)
+{
+	switch (frame)
+	{
+		case 1: return (c % 2 == 0 ? RED : GREEN);
+		case 2: return (GREEN); // Tie, the moved green goes last
+		case 3: return (GREEN);
+		case 4: return (RED); // Tie, the moved red goes last
+		case 5: return (c < 4 ? GREEN : RED);
+		default: return (GREEN);
+	}
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("depth_sort");
+	TEST_EXPECT(PASS);
+
+	// The software backend draws ties in queue order, OpenGL depth tests them.
+	mlx_set_setting(MLX_SOFTWARE, true);
+	mlx_t* mlx = mlx_init(WIDTH, HEIGHT, "TEST", false);
+	assert(mlx);
+
+	assert((red = mlx_new_image(mlx, 1, HEIGHT)));
+	assert((green = mlx_new_image(mlx, 1, HEIGHT)));
+	for (uint32_t y = 0; y < HEIGHT; y++)
+	{
+		mlx_put_pixel(red, 0, y, RED);
+		mlx_put_pixel(green, 0, y, GREEN);
+	}
+	for (int32_t c = 0; c < WIDTH; c++)
+	{
+		assert(mlx_image_to_window(mlx, red, c, 0) == c);
+		assert(mlx_image_to_window(mlx, green, c, 0) == c);
+	}
+	mlx_loop_hook(mlx, ft_frame, mlx);
+	mlx_loop(mlx);
+	mlx_terminate(mlx);
+
+	for (uint32_t frame = 0; frame < FRAMES; frame++)
+		for (uint32_t c = 0; c < WIDTH; c++)
+			assert(ft_pixel(frame, c, HEIGHT - 1) == ft_expect(frame, c));
+	TEST_EXIT(EXIT_SUCCESS);
+}
@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   stats_test.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:50:39 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:24:14 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+#include "MLX42/MLX42_Int.h"
+
+#define FRAMES 64
+
+static mlx_image_t* img = NULL;
+static uint32_t timed = 0;
+
+// Check the stats of the previous frame every frame.
+static void ft_check(void* param)
+{
+	static uint32_t frame = 0;
+	static bool enabled = true;
+	static bool began = true;
+	mlx_t* const mlx = param;
+
+	mlx_frame_stats_t stats;
+	mlx_get_frame_stats(mlx, &stats);
+
+	// Toggling the stats from a hook only affects the next frame, queries included.
+	assert(glGetError() == GL_NO_ERROR);
+	assert(began || (stats.frame_time == 0 && stats.gpu_time == -1));
+	began = enabled;
+	timed += enabled;
+	enabled = frame < 32 || frame >= 48 || (frame * 7) % 5 < 2;
+	mlx_set_setting(MLX_FRAME_STATS, enabled);
+	if (frame > 0)
+	{
+		assert(stats.instances == 16);
+		assert(stats.draw_calls >= 1);
+		assert(stats.upload_bytes == img->width * img->height * sizeof(int32_t));
+		assert(stats.vertex_bytes > 0);
+		assert(stats.frame_time >= 0);
+	}
+	if (++frame >= FRAMES)
+		mlx_close_window(mlx);
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("frame_stats");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_set_setting(MLX_FRAME_STATS, true);
+	mlx_t* mlx = mlx_init(64, 64, "TEST", false);
+	assert(mlx);
+
+	img = mlx_new_image(mlx, 8, 8);
+	assert(img);
+	for (int32_t i = 0; i < 16; i++)
+		mlx_image_to_window(mlx, img, i * 2, i * 2);
+
+	mlx_loop_hook(mlx, ft_check, mlx);
+	mlx_loop(mlx);
+	assert(mlx_errno == MLX_SUCCESS);
+
+	uint32_t histogram[MLX_HISTOGRAM_SIZE];
+	uint32_t frames = 0;
+	mlx_get_frame_histogram(mlx, histogram);
+	for (int32_t i = 0; i < MLX_HISTOGRAM_SIZE; i++)
+		frames += histogram[i];
+	assert(frames == timed);
+
+	mlx_terminate(mlx);
+	TEST_EXIT(EXIT_SUCCESS);
+}
@@ -0,0 +1,104 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   stream_read_test.c                                 :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 08:04:18 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:05:03 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+
+#define WIDTH 64
+#define HEIGHT 48
+#define FRAMES 4
+
+static const uint32_t colors[FRAMES] = {0xFF0000FF, 0x00FF00FF, 0x0000FFFF, 0xFFFF00FF};
+static uint8_t frames[FRAMES][WIDTH * HEIGHT * 4];
+static mlx_image_t* ring = NULL;
+static mlx_image_t* mapped = NULL;
+
+static void ft_fill(mlx_image_t* img, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, uint32_t color)
+{
+	for (uint32_t y = y0; y < y1; y++)
+		for (uint32_t x = x0; x < x1; x++)
+			mlx_put_pixel(img, x, y, color);
+}
+
+/**
+ * Every frame a small part of the image is redrawn and uploaded. Pixels
+ * written without marking them are left out, inside the dirty rows too.
+ */
+static void ft_draw(mlx_image_t* img, uint32_t frame)
+{
+	ft_fill(img, 4, 2, 12, 6, colors[frame]);
+	mlx_put_pixel_unsafe(img, 20, 3, colors[frame]);
+	mlx_put_pixel_unsafe(img, 20, 10, colors[frame]);
+}
+
+static void ft_frame(void* param)
+{
+	static uint32_t frame = 0;
+	mlx_t* const mlx = param;
+
+	ft_draw(ring, frame);
+	ft_draw(mapped, frame);
+	mlx_read_framebuffer(mlx, frames[frame]);
+	if (++frame >= FRAMES)
+		mlx_close_window(mlx);
+}
+
+static uint32_t ft_pixel(uint32_t frame, uint32_t x, uint32_t y)
+{
+	const uint8_t* pixel = &frames[frame][(y * WIDTH + x) * 4];
+
+	return ((uint32_t)pixel[0] << 24 | pixel[1] << 16 | pixel[2] << 8 | pixel[3]);
+}
+
+// The image sits at the given offset, the first frame uploads all of it.
+static void ft_check(uint32_t frame, uint32_t ox, uint32_t oy)
+{
+	assert(ft_pixel(frame, ox + 4, oy + 2) == colors[frame]);
+	assert(ft_pixel(frame, ox + 11, oy + 5) == colors[frame]);
+	assert(ft_pixel(frame, ox + 3, oy + 2) == 0x000000FF);
+	assert(ft_pixel(frame, ox + 12, oy + 5) == 0x000000FF);
+	assert(ft_pixel(frame, ox + 4, oy + 6) == 0x000000FF);
+	assert(ft_pixel(frame, ox + 20, oy + 3) == colors[0]);
+	assert(ft_pixel(frame, ox + 20, oy + 10) == colors[0]);
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("stream_read");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_set_setting(MLX_DIRTY_TRACKING, true);
+	mlx_t* mlx = mlx_init(WIDTH, HEIGHT, "TEST", false);
+	assert(mlx);
+
+	assert((ring = mlx_new_image(mlx, 32, 16)));
+	assert(mlx_set_image_streaming(ring, true));
+	ft_fill(ring, 0, 0, 32, 16, 0x000000FF);
+	mlx_image_to_window(mlx, ring, 0, 0);
+
+	// Only the dirty rows of the mapping are flushed, of which only the rect is uploaded.
+	assert((mapped = mlx_new_streaming_image(mlx, 32, 16)));
+	ft_fill(mapped, 0, 0, 32, 16, 0x000000FF);
+	mlx_image_to_window(mlx, mapped, 0, 24);
+
+	mlx_loop_hook(mlx, ft_frame, mlx);
+	mlx_loop(mlx);
+	mlx_terminate(mlx);
+
+	for (uint32_t frame = 0; frame < FRAMES; frame++)
+	{
+		ft_check(frame, 0, 0);
+		ft_check(frame, 0, 24);
+	}
+	TEST_EXIT(EXIT_SUCCESS);
+}
@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   stream_test.c                                      :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:29:44 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 06:31:48 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+
+static mlx_image_t* img = NULL;
+
+static void ft_draw(void* param)
+{
+	static int32_t frame = 0;
+	mlx_t* const mlx = param;
+
+	memset(img->pixels, frame & 0xFF, img->width * img->height * sizeof(int32_t));
+	if (frame == 16)
+		assert(mlx_resize_image(img, 48, 24));
+	if (++frame >= 32)
+		mlx_close_window(mlx);
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("img_stream");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	mlx_t* mlx = mlx_init(64, 64, "TEST", false);
+	assert(mlx);
+
+	img = mlx_new_image(mlx, 64, 64);
+	assert(img);
+	assert(mlx_set_image_streaming(img, true));
+	assert(mlx_set_image_streaming(img, true));
+	mlx_image_to_window(mlx, img, 0, 0);
+
+	// Streaming can be toggled at any time.
+	mlx_image_t* img2 = mlx_new_image(mlx, 16, 16);
+	assert(img2);
+	assert(mlx_set_image_streaming(img2, true));
+	assert(mlx_set_image_streaming(img2, false));
+	assert(mlx_set_image_streaming(img2, true));
+	mlx_image_to_window(mlx, img2, 8, 8);
+
+	// Mapped images behave like any other image.
+	mlx_image_t* img3 = mlx_new_streaming_image(mlx, 32, 32);
+	assert(img3);
+	memset(img3->pixels, 255, img3->width * img3->height * sizeof(int32_t));
+	mlx_image_to_window(mlx, img3, 16, 16);
+	assert(mlx_resize_image(img3, 40, 40));
+	mlx_put_pixel(img3, 39, 39, 0xFF0000FF);
+
+	mlx_loop_hook(mlx, ft_draw, mlx);
+	mlx_loop(mlx);
+	mlx_delete_image(mlx, img2);
+	assert(mlx_set_image_streaming(img3, false));
+	mlx_put_pixel(img3, 0, 0, 0xFF0000FF);
+	assert(mlx_errno == MLX_SUCCESS);
+	mlx_terminate(mlx);
+	TEST_EXIT(EXIT_SUCCESS);
+}
@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   trace_test.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2026/10/18 06:52:40 by W2Wizard      #+#    #+#                 */
+/*   Updated: 2026/10/18 08:25:08 by W2Wizard      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "Tester.h"
+#include "MLX42/MLX42.h"
+
+#define TRACE_PATH "trace_test.json"
+
+static uint32_t frame = 0;
+
+static void ft_close(void* param)
+{
+	if (++frame >= 8)
+		mlx_close_window(param);
+}
+
+// Traces a few frames, the events of each thread go onto a track of its own.
+static void ft_trace(bool pipelined)
+{
+	frame = 0;
+	mlx_set_setting(MLX_PIPELINED, pipelined);
+	mlx_t* mlx = mlx_init(64, 64, "TEST", false);
+	assert(mlx);
+	assert(mlx_start_trace(mlx, TRACE_PATH));
+
+	mlx_image_t* img = mlx_new_image(mlx, 8, 8);
+	assert(img);
+	mlx_image_to_window(mlx, img, 0, 0);
+	assert(mlx_named_loop_hook(mlx, ft_close, mlx, "close \"soon\""));
+	mlx_loop(mlx);
+	mlx_terminate(mlx);
+
+	// Every frame runs the hook and swaps, the names are escaped.
+	FILE* file = fopen(TRACE_PATH, "r");
+	assert(file);
+	char line[512];
+	uint32_t hooks = 0, swaps = 0;
+	uint32_t hook_thread = 0, swap_thread = 0;
+	assert(fgets(line, sizeof(line), file) && !strcmp(line, "{\"traceEvents\":[\n"));
+	while (fgets(line, sizeof(line), file))
+	{
+		const char* tid = strstr(line, "\"tid\":");
+		uint32_t thread = 0;
+		if (tid)
+			assert(sscanf(tid, "\"tid\":%u", &thread) == 1 && thread > 0);
+		if (strstr(line, "{\"name\":\"close \\\"soon\\\"\""))
+		{
+			assert(!hook_thread || hook_thread == thread);
+			hook_thread = thread;
+			hooks++;
+		}
+		if (strstr(line, "{\"name\":\"swap\""))
+		{
+			assert(!swap_thread || swap_thread == thread);
+			swap_thread = thread;
+			swaps++;
+		}
+	}
+	assert(hooks == 8 && swaps == 8);
+	assert(pipelined ? hook_thread != swap_thread : hook_thread == swap_thread);
+	fclose(file);
+	remove(TRACE_PATH);
+}
+
+int32_t main(void)
+{
+	TEST_DECLARE("trace");
+	TEST_EXPECT(PASS);
+
+	mlx_set_setting(MLX_HEADLESS, true);
+	ft_trace(false);
+	ft_trace(true);
+	TEST_EXIT(EXIT_SUCCESS);
+}